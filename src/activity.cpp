@@ -27,14 +27,16 @@ THE SOFTWARE.
 #include "truncatingfilelogger.h"
 #include "dwarfjob.h"
 
-Activity::Activity(DFInstance *df, VPTR addr, QObject *parent)
+Activity::Activity(DFInstance *df, VPTR addr, const QSet<int> *units, QObject *parent)
     :QObject(parent)
     , m_df(df)
     , m_address(addr)
     , m_id(-1)
     , m_type(ACT_NONE)
+    , m_units(units)
 {
     read_data();
+    m_units = 0; //only valid while reading
 }
 
 Activity::~Activity(){
@@ -60,7 +62,7 @@ void Activity::read_data(){
         //ie. training->combat training->skill demonstration so the last items are the most specific
         QVector<VPTR> events = m_df->enumerate_vector(m_address + mem->activity_offset("events"));
         for(int idx=events.count()-1;idx>=0;idx--){
-            ActivityEvent *ae = new ActivityEvent(m_df,events.at(idx),&m_histfig_actions,this);
+            ActivityEvent *ae = new ActivityEvent(m_df,events.at(idx),&m_histfig_actions,m_units,this);
             if(ae){
                 m_events.insert(ae->id(),ae);
             }
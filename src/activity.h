@@ -25,6 +25,7 @@ THE SOFTWARE.
 
 #include "utils.h"
 #include <QObject>
+#include <QSet>
 
 class DFInstance;
 class MemoryLayout;
@@ -33,7 +34,7 @@ class ActivityEvent;
 class Activity : public QObject {
     Q_OBJECT
 public:
-    Activity(DFInstance *df, VPTR addr, QObject *parent = 0);
+    Activity(DFInstance *df, VPTR addr, const QSet<int> *units = 0, QObject *parent = 0);
     virtual ~Activity();
 
     typedef enum{
@@ -56,6 +57,7 @@ public:
     ACT_CATEGORY activity_type() {return m_type;}
     QPair<int, QString> find_activity(int histfig_id);
     int activity_count() {return m_histfig_actions.count();}
+    const QHash<int, QPair<int, QString> > &histfig_actions() const {return m_histfig_actions;}
 
 private:
     DFInstance * m_df;
@@ -66,6 +68,7 @@ private:
     ACT_CATEGORY m_type;
     QHash<int, ActivityEvent*> m_events;
     QHash<int, QPair<int,QString> > m_histfig_actions;
+    const QSet<int> *m_units;
 
     void read_data();
 };
@@ -26,15 +26,17 @@ THE SOFTWARE.
 #include "gamedatareader.h"
 #include "dwarfjob.h"
 
-ActivityEvent::ActivityEvent(DFInstance *df, VPTR addr, QHash<int, QPair<int,QString> > *histfig_actions, QObject *parent)
+ActivityEvent::ActivityEvent(DFInstance *df, VPTR addr, QHash<int, QPair<int,QString> > *histfig_actions, const QSet<int> *units, QObject *parent)
     :QObject(parent)
     , m_df(df)
     , m_address(addr)
     , m_histfig_actions(histfig_actions)
+    , m_units(units)
     , m_id(-1)
     , m_type(ACT_UNKNOWN)
 {
     read_data();
+    m_units = 0; //only valid while reading
 }
 
 void ActivityEvent::read_data(){
@@ -61,7 +63,7 @@ void ActivityEvent::read_data(){
 
         if(event_type == SERVICE_ORDER || event_type == COPY_WRITTEN){ //only a single participant
             int id = m_df->read_int(m_address + mem->activity_offset("participants"));
-            if(!m_histfig_actions->contains(id)){
+            if(involves(id) && !m_histfig_actions->contains(id)){
                 add_action(id,event_type);
             }
             //vectors after the participants has id numbers that correspond to either the artifact being copied, or the drink/food being served
@@ -73,8 +75,8 @@ void ActivityEvent::read_data(){
 
             foreach(qint32 histfig_id,participants){
                 event_type = m_type;
-                //single participants
-                if(m_histfig_actions->contains(histfig_id)){
+                //single participants, performances check their own participant list below
+                if(m_histfig_actions->contains(histfig_id) || (event_type != PERFORM && !involves(histfig_id))){
                     continue;
                 }
                 //squad lead participants, check and change type or cancel if necessary
@@ -100,7 +102,7 @@ void ActivityEvent::read_data(){
                         VPTR histfig_addr = m_df->find_historical_figure(m_df->read_short(m_address + mem->activity_offset("pray_deity")));
                         if(histfig_addr){
                             add_action(histfig_id,event_type,
-                                       tr("Pray to %1").arg(m_df->get_name(histfig_addr + m_df->memory_layout()->hist_figure_offset("hist_name"),true)));
+                                       tr("Pray to %1").arg(m_df->get_name(histfig_addr + m_df->memory_layout()->hist_figure_offset(MemoryLayout::HF_HIST_NAME),true)));
                             continue;
                         }
                     }else{
@@ -120,7 +122,7 @@ void ActivityEvent::read_data(){
                     QVector<VPTR> p_participants = m_df->enumerate_vector(m_address + mem->activity_offset("perf_participants"));
                     foreach(VPTR p_addr, p_participants){
                         int id = m_df->read_int(p_addr + mem->activity_offset("perf_histfig"));
-                        if(m_histfig_actions->contains(id)){
+                        if(m_histfig_actions->contains(id) || !involves(id)){
                             continue;
                         }
                         ACT_PERF_TYPE par_type = static_cast<ACT_PERF_TYPE>(m_df->read_int(p_addr));
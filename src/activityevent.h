@@ -24,6 +24,7 @@ THE SOFTWARE.
 #define ACTIVITYEVENT
 
 #include <QObject>
+#include <QSet>
 #include "utils.h"
 
 class DFInstance;
@@ -31,7 +32,7 @@ class DFInstance;
 class ActivityEvent : public QObject {
     Q_OBJECT
 public:
-    ActivityEvent(DFInstance *df, VPTR addr, QHash<int, QPair<int, QString> > *histfig_actions, QObject *parent = 0);
+    ActivityEvent(DFInstance *df, VPTR addr, QHash<int, QPair<int, QString> > *histfig_actions, const QSet<int> *units = 0, QObject *parent = 0);
 
     typedef enum {
         ACT_UNKNOWN = -1,
@@ -106,10 +107,13 @@ public:
 
     short id(){return m_id;}
 
+    bool involves(int histfig_id) const {return !m_units || m_units->contains(histfig_id);}
+
 private:
     DFInstance *m_df;
     VPTR m_address;
     QHash<int,QPair<int, QString> > *m_histfig_actions;
+    const QSet<int> *m_units; //historical figures of the units we care about, all if null
 
     short m_id;
     ACT_EVT_TYPE m_type;
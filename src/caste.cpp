@@ -71,10 +71,15 @@ void Caste::load_data() {
 }
 
 void Caste::read_caste() {
-    m_tag = m_df->read_string(m_address);
-    m_name = capitalizeEach(m_df->read_string(m_address + m_mem->caste_offset("caste_name")));
-    m_name_plural = capitalizeEach(m_df->read_string(m_address + m_mem->word_offset("noun_plural")));
-    m_description = m_df->read_string(m_address + m_mem->caste_offset("caste_descr"));
+    QStringList names = m_df->read_strings(QVector<VPTR>()
+            << m_address
+            << m_address + m_mem->caste_offset("caste_name")
+            << m_address + m_mem->word_offset(MemoryLayout::WORD_NOUN_PLURAL)
+            << m_address + m_mem->caste_offset("caste_descr"));
+    m_tag = names.at(0);
+    m_name = capitalizeEach(names.at(1));
+    m_name_plural = capitalizeEach(names.at(2));
+    m_description = names.at(3);
 
     m_flags = FlagArray(m_df, m_address + m_mem->caste_offset("flags"));
 
@@ -141,12 +146,15 @@ void Caste::load_skill_rates(){
         VPTR addr = m_address + m_mem->caste_offset("skill_rates");
         int val;
         int skill_count = GameDataReader::ptr()->get_total_skill_count();
+        QVector<qint32> rates(skill_count);
+        DFInstance::ReadBatch batch;
+        batch.add_raw(addr, skill_count * sizeof(qint32), rates.data());
+        m_df->read_batch(batch);
         for(int skill_id=0; skill_id < skill_count; skill_id++){
-            val = (int)m_df->read_int(addr);
+            val = rates.at(skill_id);
             m_skill_rates.insert(skill_id, val);
             if((val-100) >= 25)
                 m_bonuses.append(GameDataReader::ptr()->get_skill_name(skill_id));
-            addr += 0x4;
             if(!DT->show_skill_learn_rates() && val != 100)
                 DT->show_skill_learn_rates(true);
         }
@@ -170,18 +178,28 @@ void Caste::load_attribute_info(){
     int median = 0;
     int display_max = 0; //maximum display descriptor value, seems to be the median + 1000?
     int cost_to_improve = 500; //cost to improve default is 500
+
+    //the ranges, caps and rates are each stored as fixed arrays, fetch them together
+    qint32 ranges[19][7];
+    qint32 caps[19];
+    qint32 rates[19][4];
+    DFInstance::ReadBatch batch;
+    batch.add(base, ranges);
+    batch.add(base_caps, caps);
+    batch.add(base_rates, rates);
+    m_df->read_batch(batch);
+
     for (int i=0; i<19; i++)
     {
         att_range r;
         for (int j=0; j<7; j++){
-            int val = m_df->read_int(base + i*28 + j*4);
-            r.raw_bins.append(val);
+            r.raw_bins.append(ranges[i][j]);
         }
         median = r.raw_bins.at(3);
         display_max = median + 1000; //maybe this is based on the perc below?
 
         //add a bin between the max raw value, and the 5000 limit, based on the max %
-        perc = m_df->read_int(base_caps + i*4);
+        perc = caps[i];
         limit = r.raw_bins.at(6) * (perc/100);
         r.raw_bins.append(limit);
 
@@ -189,7 +207,7 @@ void Caste::load_attribute_info(){
         r.raw_bins.append(5000);
 
         //also save the cost to improve for this attribute for the caste
-        cost_to_improve = m_df->read_int(base_rates + i*16);
+        cost_to_improve = rates[i][0];
         m_attrib_costs.insert(i,cost_to_improve);
 
         //now load the display/descriptor ranges
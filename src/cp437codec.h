@@ -120,6 +120,15 @@ public:
         return 2011;
     }
 
+    //! decode straight from the table, without looking the codec up by name
+    static QString decode(const char *in, int length) {
+        QString str(length, Qt::Uninitialized);
+        QChar *out = str.data();
+        for (int i = 0; i < length; ++i)
+            out[i] = QChar(cp437ToUnicode[static_cast<uchar>(in[i])]);
+        return str;
+    }
+
 protected:
     QString convertToUnicode(const char *in, int length, ConverterState *) const {
         QString str;
@@ -24,7 +24,10 @@ THE SOFTWARE.
 #include "dfinstance.h"
 #include "cp437codec.h"
 #include "dwarf.h"
+#include "caste.h"
 #include "squad.h"
+#include "uniform.h"
+#include "itemdefuniform.h"
 #include "word.h"
 #include "gamedatareader.h"
 #include "memorylayout.h"
@@ -50,10 +53,19 @@ THE SOFTWARE.
 #include "equipwarn.h"
 #include "unitemotion.h"
 #include "rolecalcbase.h"
+#include "rolematrix.h"
+#include "rolescriptengine.h"
 
 #include <QTimer>
 #include <QTime>
 #include <QInputDialog>
+#include <QDataStream>
+#include <QCryptographicHash>
+#include <QFile>
+#include <QAtomicInt>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QCoreApplication>
 
 #ifdef Q_OS_WIN
 #define LAYOUT_SUBDIR "windows"
@@ -65,6 +77,7 @@ THE SOFTWARE.
 #define LAYOUT_SUBDIR "osx"
 #include "dfinstanceosx.h"
 #endif
+#include "dfinstancesnapshot.h"
 
 quint32 DFInstance::ticks_per_day = 1200;
 quint32 DFInstance::ticks_per_month = 28 * DFInstance::ticks_per_day;
@@ -89,13 +102,31 @@ DFInstance::DFInstance(QObject* parent)
     , m_alloc_capacity(0)
     , m_languages(0x0)
     , m_fortress(0x0)
+    , m_page_cache(0)
+    , m_cache_generation(0)
+    , m_cache_hits(0)
+    , m_cache_misses(0)
+    , m_regions_known(false)
+    , m_regions_generation(0)
+    , m_rejected_reads(0)
+    , m_recording(false)
+    , m_histfig_search(true)
+    , m_identities_loaded(false)
+    , m_items_generation(0)
     , m_fortress_name(tr("Embarking"))
     , m_fortress_name_translated("")
     , m_squad_vector(0)
+    , m_probe_time(0)
+    , m_units_year(0)
+    , m_prefetching_units(false)
+    , m_role_ratings_dirty(true)
 {
     // let subclasses start the heartbeat timer, since we don't want to be
     // checking before we're connected
     connect(m_heartbeat_timer, SIGNAL(timeout()), SLOT(heartbeat()));
+    // unit validation depends on the settings, so read everything again when they change
+    connect(DT, SIGNAL(settings_changed()), SLOT(reset_unit_fingerprints()));
+    connect(DT, SIGNAL(roles_changed()), SLOT(roles_changed()));
 
     QDir d(QString("share:memory_layouts/%1").arg(LAYOUT_SUBDIR));
     d.setNameFilters(QStringList() << "*.ini");
@@ -126,13 +157,26 @@ DFInstance::DFInstance(QObject* parent)
 }
 
 DFInstance * DFInstance::newInstance(){
+    // -replay <file> reads a recorded snapshot instead of a running game
+    QStringList args = QCoreApplication::arguments();
+    int idx = args.indexOf("-replay");
+    if (idx != -1 && idx + 1 < args.count())
+        return new DFInstanceSnapshot(args.at(idx + 1));
+
+    DFInstance *df = 0;
 #ifdef Q_OS_WIN
-    return new DFInstanceWindows();
+    df = new DFInstanceWindows();
 #elif defined(Q_OS_MAC)
-    return new DFInstanceOSX();
+    df = new DFInstanceOSX();
 #elif defined(Q_OS_LINUX)
-    return new DFInstanceLinux();
+    df = new DFInstanceLinux();
 #endif
+
+    // -record <file> saves everything read during the first full load
+    idx = args.indexOf("-record");
+    if (df && idx != -1 && idx + 1 < args.count())
+        df->start_recording(args.at(idx + 1));
+    return df;
 }
 
 bool DFInstance::check_vector(const VPTR start, const VPTR end, const VPTR addr){
@@ -214,11 +258,206 @@ QVector<qint16> DFInstance::enumerate_vector_short(const VPTR addr){
     return enum_vec<qint16>(addr);
 }
 
+size_t DFInstance::read_raw(VPTR addr, size_t bytes, void *buf) {
+    // only the start is checked, reads running off the end of a mapping are still partially filled
+    if (!is_valid_address(addr)) {
+        m_rejected_reads++;
+        TRACE << "rejected read of" << bytes << "bytes from unmapped address" << hexify(addr);
+        memset(buf, 0, bytes);
+        return 0;
+    }
+    if (m_recording)
+        return read_recorded(addr, bytes, buf);
+    if (bytes == 0 || bytes > remote_page_size || m_page_cache.maxCost() <= 0)
+        return read_process_memory(addr, bytes, buf);
+
+    // a read no bigger than a page spans at most two pages
+    quintptr start = reinterpret_cast<quintptr>(addr);
+    quintptr first_page = start & ~(quintptr)(remote_page_size - 1);
+    quintptr last_page = (start + bytes - 1) & ~(quintptr)(remote_page_size - 1);
+    char *out = static_cast<char *>(buf);
+    size_t copied = 0;
+    for (quintptr page = first_page; page <= last_page; page += remote_page_size) {
+        const char *data = cached_page(page);
+        if (!data) {
+            // the whole page is unreadable, so is the rest of the request
+            memset(out + copied, 0, bytes - copied);
+            break;
+        }
+        size_t offset = start + copied - page;
+        size_t len = remote_page_size - offset;
+        if (len > bytes - copied)
+            len = bytes - copied;
+        memcpy(out + copied, data + offset, len);
+        copied += len;
+    }
+    return copied;
+}
+
+const char *DFInstance::cached_page(quintptr page) {
+    remote_page *p = m_page_cache.object(page);
+    if (p && p->generation == m_cache_generation) {
+        m_cache_hits++;
+        return p->data;
+    }
+    m_cache_misses++;
+
+    // stale pages are refilled in place
+    bool is_new = !p;
+    if (is_new)
+        p = new remote_page;
+    if (read_process_memory(reinterpret_cast<VPTR>(page), remote_page_size, p->data) != remote_page_size) {
+        if (is_new)
+            delete p;
+        else
+            m_page_cache.remove(page);
+        return 0;
+    }
+    p->generation = m_cache_generation;
+    if (is_new && !m_page_cache.insert(page, p, remote_page_size))
+        return 0;
+    return p->data;
+}
+
+bool DFInstance::is_valid_address(VPTR addr, size_t bytes) {
+    if (!m_regions_known)
+        return true;
+
+    quintptr start = reinterpret_cast<quintptr>(addr);
+    if (region_contains(start, bytes))
+        return true;
+    if (start < remote_page_size)
+        return false;
+
+    // the process may have mapped more memory since the index was built,
+    // but only look again once per cache generation
+    if (m_regions_generation != m_cache_generation) {
+        refresh_memory_regions();
+        return !m_regions_known || region_contains(start, bytes);
+    }
+    return false;
+}
+
+bool DFInstance::region_contains(quintptr start, size_t bytes) const {
+    QMap<quintptr, quintptr>::const_iterator it = m_regions.upperBound(start);
+    if (it == m_regions.constBegin())
+        return false;
+    --it;
+    return start + bytes <= it.value() && start + bytes >= start;
+}
+
+void DFInstance::refresh_memory_regions() {
+    m_regions.clear();
+    m_regions_known = load_memory_regions(m_regions);
+    m_regions_generation = m_cache_generation;
+    TRACE << "indexed" << m_regions.count() << "readable memory regions";
+}
+
+void DFInstance::start_recording(const QString &path) {
+    LOGI << "recording memory reads to" << path;
+    m_record_path = path;
+    m_recorded_pages.clear();
+    m_recording = true;
+}
+
+size_t DFInstance::read_recorded(VPTR addr, size_t bytes, void *buf) {
+    // pages are captured the first time they're read and every later read is served from
+    // them, so the snapshot holds exactly the memory this load saw
+    quintptr start = reinterpret_cast<quintptr>(addr);
+    char *out = static_cast<char *>(buf);
+    size_t copied = 0;
+    while (copied < bytes) {
+        quintptr page = (start + copied) & ~(quintptr)(remote_page_size - 1);
+        QMap<quintptr, QByteArray>::iterator it = m_recorded_pages.find(page);
+        if (it == m_recorded_pages.end()) {
+            QByteArray data(remote_page_size, 0);
+            if (read_process_memory(reinterpret_cast<VPTR>(page), remote_page_size, data.data()) != remote_page_size)
+                data.clear();
+            it = m_recorded_pages.insert(page, data);
+        }
+        if (it.value().isEmpty()) {
+            memset(out + copied, 0, bytes - copied);
+            break;
+        }
+        size_t offset = start + copied - page;
+        size_t len = qMin(remote_page_size - offset, bytes - copied);
+        memcpy(out + copied, it.value().constData() + offset, len);
+        copied += len;
+    }
+    return copied;
+}
+
+bool DFInstance::finish_recording() {
+    if (!m_recording)
+        return false;
+    m_recording = false;
+
+    // join neighbouring pages into runs, the map is already sorted by address
+    QMap<quintptr, QByteArray> runs;
+    quintptr run_start = 0;
+    QByteArray run;
+    int page_count = 0;
+    for (QMap<quintptr, QByteArray>::const_iterator it = m_recorded_pages.constBegin(); it != m_recorded_pages.constEnd(); ++it) {
+        if (it.value().isEmpty())
+            continue;
+        page_count++;
+        if (!run.isEmpty() && run_start + run.size() == it.key()) {
+            run.append(it.value());
+        } else {
+            if (!run.isEmpty())
+                runs.insert(run_start, run);
+            run_start = it.key();
+            run = it.value();
+        }
+    }
+    if (!run.isEmpty())
+        runs.insert(run_start, run);
+    m_recorded_pages.clear();
+
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out << snapshot_magic << snapshot_version << m_df_checksum
+        << (quint64)reinterpret_cast<quintptr>(m_base_addr) << m_df_dir.absolutePath()
+        << (quint32)runs.count();
+    for (QMap<quintptr, QByteArray>::const_iterator it = runs.constBegin(); it != runs.constEnd(); ++it) {
+        out << (quint64)it.key() << it.value();
+    }
+
+    QFile file(m_record_path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        LOGE << "Unable to write snapshot" << m_record_path;
+        return false;
+    }
+    file.write(qCompress(data));
+    LOGI << "saved" << page_count << "pages in" << runs.count() << "regions to" << m_record_path;
+    return true;
+}
+
 size_t DFInstance::read_raw(VPTR addr, size_t bytes, QByteArray &buffer) {
     buffer.resize(bytes);
     return read_raw(addr, bytes, buffer.data());
 }
 
+size_t DFInstance::read_batch(const ReadBatch &batch) {
+    size_t total = 0;
+    foreach(const ReadBatch::request &r, batch.requests()){
+        size_t bytes_read = read_raw(r.addr, r.bytes, r.buf);
+        if(bytes_read < r.bytes)
+            memset(static_cast<char *>(r.buf) + bytes_read, 0, r.bytes - bytes_read);
+        total += bytes_read;
+    }
+    return total;
+}
+
+QStringList DFInstance::read_strings(const QVector<VPTR> &addrs) {
+    QStringList result;
+    result.reserve(addrs.count());
+    foreach(VPTR addr, addrs){
+        result.append(read_string(addr));
+    }
+    return result;
+}
+
 quint8 DFInstance::read_byte(VPTR addr) {
     return read_mem<quint8>(addr);
 }
@@ -243,12 +482,22 @@ size_t DFInstance::write_int(VPTR addr, const int val) {
     return write_raw(addr, sizeof(int), &val);
 }
 
+size_t DFInstance::write_raw(VPTR addr, size_t bytes, const void *buffer) {
+    invalidate_cache();
+    return write_process_memory(addr, bytes, buffer);
+}
+
 size_t DFInstance::write_raw(const VPTR addr, const size_t bytes, const QByteArray &buffer) {
     return write_raw(addr, bytes, buffer.data());
 }
 
 void DFInstance::load_game_data()
 {
+    // stay attached for the whole load rather than once per read
+    bool session = reads_stop_process();
+    if(session)
+        attach();
+
     emit progress_message(tr("Loading languages"));
     if(m_languages){
         delete m_languages;
@@ -286,6 +535,8 @@ void DFInstance::load_game_data()
     load_item_defs();
 
     load_fortress_name();
+    if(session)
+        detach();
 }
 
 QString DFInstance::get_language_word(VPTR addr){
@@ -298,7 +549,7 @@ QString DFInstance::get_translated_word(VPTR addr){
 
 QString DFInstance::get_name(VPTR addr, bool translate){
     QString f_name = read_string(addr);
-    QString n_name = read_string(addr + m_layout->dwarf_offset("nick_name"));
+    QString n_name = read_string(addr + m_layout->dwarf_offset(MemoryLayout::DWARF_NICK_NAME));
     if(!n_name.isEmpty()){
         n_name = "'" + n_name + "'";
     }
@@ -310,7 +561,147 @@ QString DFInstance::get_name(VPTR addr, bool translate){
     return capitalizeEach(QString("%1 %2 %3").arg(f_name).arg(n_name).arg(l_name).simplified());
 }
 
-QVector<Dwarf*> DFInstance::load_dwarves() {
+//! reads the raw unit and soul structs for a slice of the creature vector, on a worker thread when concurrent
+class UnitPrefetcher : public QRunnable {
+public:
+    UnitPrefetcher(DFInstance *df, DFInstance::unit_prefetch *units, int count, QAtomicInt *done, bool concurrent)
+        : m_df(df)
+        , m_units(units)
+        , m_count(count)
+        , m_done(done)
+        , m_concurrent(concurrent)
+    {}
+
+    void run() {
+        MemoryLayout *mem = m_df->memory_layout();
+        uint unit_size = mem->unit_size();
+        uint soul_size = mem->soul_size();
+        VPTRDIFF souls_offset = mem->dwarf_offset(MemoryLayout::DWARF_SOULS);
+
+        for (int i = 0; i < m_count; ++i) {
+            DFInstance::unit_prefetch &u = m_units[i];
+            u.soul = 0;
+            u.unit.resize(unit_size);
+            u.unit.resize(read(u.addr, unit_size, u.unit.data()));
+
+            // only units with exactly one soul are loaded
+            VPTR souls[2] = {0, 0};
+            if (souls_offset >= 0 && (size_t)u.unit.size() >= souls_offset + sizeof(souls))
+                memcpy(souls, u.unit.constData() + souls_offset, sizeof(souls));
+            if (souls[0] && souls[1] - souls[0] == sizeof(VPTR) &&
+                    read(souls[0], sizeof(VPTR), &u.soul) == sizeof(VPTR) && u.soul && soul_size > 0) {
+                u.soul_data.resize(soul_size);
+                u.soul_data.resize(read(u.soul, soul_size, u.soul_data.data()));
+            }
+            m_done->fetchAndAddRelaxed(1);
+        }
+    }
+
+private:
+    DFInstance *m_df;
+    DFInstance::unit_prefetch *m_units;
+    int m_count;
+    QAtomicInt *m_done;
+    bool m_concurrent;
+
+    size_t read(VPTR addr, size_t bytes, void *buf) {
+        return m_concurrent ? m_df->read_concurrent(addr, bytes, buf) : m_df->read_raw(addr, bytes, buf);
+    }
+};
+
+bool DFInstance::can_prefetch_units() {
+    return m_layout->unit_size() > 0 && DT->user_settings()->value("options/read_unit_snapshots", true).toBool();
+}
+
+void DFInstance::prefetch_units(const QVector<VPTR> &addrs) {
+    m_unit_prefetch.clear();
+    if (!can_prefetch_units())
+        return;
+
+    QVector<unit_prefetch> units(addrs.count());
+    for (int i = 0; i < addrs.count(); ++i)
+        units[i].addr = addrs.at(i);
+
+    QAtomicInt done(0);
+    unit_prefetch *data = units.data();
+    emit progress_message(tr("Reading units"));
+    if (concurrent_reads() && !m_recording && DT->user_settings()->value("options/parallel_unit_load", true).toBool()) {
+        // split the units into a few slices per thread so the load stays balanced
+        QThreadPool pool;
+        int slices = qMax(1, pool.maxThreadCount() * 4);
+        int slice_size = qMax(1, (units.count() + slices - 1) / slices);
+        for (int start = 0; start < units.count(); start += slice_size) {
+            pool.start(new UnitPrefetcher(this, data + start, qMin(slice_size, units.count() - start), &done, true));
+        }
+
+        // keep repainting the progress bar while the workers read, the heartbeat
+        // stays quiet meanwhile so it can't invalidate the cache mid load
+        m_prefetching_units = true;
+        while (!pool.waitForDone(50)) {
+            emit progress_value(done.load());
+            QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+        }
+        m_prefetching_units = false;
+        LOGD << "prefetched" << units.count() << "units on" << pool.maxThreadCount() << "threads";
+    } else {
+        // read through the page cache (and any recording) on this thread instead
+        const int slice_size = 64;
+        for (int start = 0; start < units.count(); start += slice_size) {
+            UnitPrefetcher(this, data + start, qMin(slice_size, units.count() - start), &done, false).run();
+            emit progress_value(done.load());
+        }
+    }
+
+    foreach(const unit_prefetch &u, units) {
+        m_unit_prefetch.insert(u.addr, u);
+    }
+    emit progress_message(tr("Loading Units"));
+}
+
+bool DFInstance::take_prefetched_unit(VPTR addr, QByteArray &data) {
+    QHash<VPTR, unit_prefetch>::iterator it = m_unit_prefetch.find(addr);
+    if (it == m_unit_prefetch.end() || it->unit.isEmpty())
+        return false;
+    data = it->unit;
+    it->unit.clear();
+    return true;
+}
+
+bool DFInstance::take_prefetched_soul(VPTR addr, VPTR soul, QByteArray &data) {
+    QHash<VPTR, unit_prefetch>::iterator it = m_unit_prefetch.find(addr);
+    if (it == m_unit_prefetch.end())
+        return false;
+    unit_prefetch u = *it;
+    m_unit_prefetch.erase(it);
+    if (u.soul != soul || u.soul_data.isEmpty())
+        return false;
+    data = u.soul_data;
+    return true;
+}
+
+QByteArray DFInstance::unit_fingerprint(VPTR unit) {
+    // any change to the unit or soul struct reads the unit again. vectors and
+    // records they point to (skills, preferences, the current job) are only
+    // picked up along with a change to the structs themselves
+    QHash<VPTR, unit_prefetch>::const_iterator it = m_unit_prefetch.constFind(unit);
+    if (it == m_unit_prefetch.constEnd() || it->unit.isEmpty())
+        return QByteArray();
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    hash.addData(it->unit);
+    hash.addData(it->soul_data);
+    return hash.result();
+}
+
+void DFInstance::reset_unit_fingerprints() {
+    m_unit_fingerprints.clear();
+    m_rejected_units.clear();
+}
+
+void DFInstance::roles_changed() {
+    m_role_ratings_dirty = true;
+}
+
+QVector<Dwarf*> DFInstance::load_dwarves(const QHash<int, Dwarf*> &previous) {
     QVector<Dwarf*> dwarves;
     if (m_status < DFS_LAYOUT_OK) {
         LOGE << "Could not load units: disconnected or invalid memory layout";
@@ -338,15 +729,77 @@ QVector<Dwarf*> DFInstance::load_dwarves() {
 
     QVector<VPTR> creatures_addrs = get_creatures();
 
-    emit progress_range(0, creatures_addrs.size()-1);
     TRACE << "FOUND" << creatures_addrs.size() << "creatures";
     QTime t;
     t.start();
     if (!creatures_addrs.empty()) {
+        // ages, and so validation, change with the year
+        if (m_units_year != m_current_year) {
+            reset_unit_fingerprints();
+            m_units_year = m_current_year;
+        }
+        // fingerprints hash the prefetched structs, without them every unit is read again
+        bool snapshots = can_prefetch_units();
+        bool incremental = snapshots && DT->user_settings()->value("options/incremental_refresh", true).toBool();
+
+        // reading the structs and decoding the units below share a single progress range
+        int prefetched = snapshots ? creatures_addrs.count() : 0;
+        emit progress_range(0, prefetched + creatures_addrs.size() - 1);
+        prefetch_units(creatures_addrs);
+
+        QHash<VPTR, Dwarf*> previous_units;
+        foreach(Dwarf *d, previous) {
+            previous_units.insert(d->address(), d);
+        }
+
+        // only read the creatures whose fingerprint changed since the last read
+        QHash<VPTR, QByteArray> fingerprints;
+        QHash<VPTR, Dwarf*> kept;
+        QSet<VPTR> changed;
+        foreach(VPTR creature_addr, creatures_addrs) {
+            QByteArray fp = unit_fingerprint(creature_addr);
+            fingerprints.insert(creature_addr, fp);
+            if (incremental && !fp.isEmpty() && m_unit_fingerprints.value(creature_addr) == fp) {
+                Dwarf *d = previous_units.value(creature_addr);
+                // squad members hold uniforms owned by the squads refresh_data just replaced
+                if (d && !d->pending_changes() && d->squad_id(true) < 0) {
+                    kept.insert(creature_addr, d);
+                    m_unit_prefetch.remove(creature_addr);
+                    continue;
+                }
+                if (!d && m_rejected_units.contains(creature_addr)) {
+                    m_unit_prefetch.remove(creature_addr);
+                    continue;
+                }
+            }
+            changed.insert(creature_addr);
+        }
+        m_unit_fingerprints = fingerprints;
+        LOGD << "reading" << changed.count() << "changed creatures, keeping" << kept.count() << "units";
+
+        QVector<VPTR> changed_addrs;
+        foreach(VPTR creature_addr, creatures_addrs) {
+            if (changed.contains(creature_addr))
+                changed_addrs.append(creature_addr);
+        }
+
+        // resolve the figures and kill events of every unit about to be read in a few batched searches
+        QVector<int> hist_ids(changed_addrs.count(), -1);
+        ReadBatch batch;
+        for (int i = 0; i < changed_addrs.count(); ++i) {
+            batch.add(changed_addrs.at(i) + m_layout->dwarf_offset(MemoryLayout::DWARF_HIST_ID), hist_ids[i]);
+        }
+        read_batch(batch);
+        prefetch_historical_figures(hist_ids);
+        prefetch_kill_events(hist_ids);
+
+        QSet<VPTR> rejected;
         QPointer<Dwarf> d;
-        int progress_count = 0;
+        int progress_count = prefetched;
         foreach(VPTR creature_addr, creatures_addrs) {
-            d = QPointer<Dwarf>(new Dwarf(this, creature_addr,this));
+            d = kept.value(creature_addr);
+            if (d.isNull() && changed.contains(creature_addr))
+                d = QPointer<Dwarf>(new Dwarf(this, creature_addr,this));
             if(!d.isNull() && d->is_valid()){
                 dwarves.append(d);
                 if(!d->is_animal()){
@@ -358,11 +811,16 @@ QVector<Dwarf*> DFInstance::load_dwarves() {
                     }
                 }
             }else{
+                rejected.insert(creature_addr);
                 //delete d;
             }
             emit progress_value(progress_count++);
         }
+        m_unit_prefetch.clear();
+        m_rejected_units = rejected;
         LOGI << "read" << dwarves.count() << "units in" << t.elapsed() << "ms";
+        LOGD << "page cache:" << m_cache_hits << "hits," << m_cache_misses << "misses,"
+             << m_rejected_reads << "reads of unmapped memory rejected";
 
         m_enabled_labor_count.clear();
         qDeleteAll(m_pref_counts);
@@ -372,9 +830,17 @@ QVector<Dwarf*> DFInstance::load_dwarves() {
         qDeleteAll(m_equip_warning_counts);
         m_equip_warning_counts.clear();
 
-        t.restart();
-        load_role_ratings();
-        LOGI << "calculated roles in" << t.elapsed() << "ms";
+        // role ratings are relative to the population, keep them while it and the roles are unchanged
+        QStringList roles = GameDataReader::ptr()->get_roles().keys();
+        qSort(roles);
+        if (m_role_ratings_dirty || roles != m_rated_roles ||
+                kept.count() != dwarves.count() || kept.count() != previous.count()) {
+            t.restart();
+            load_role_ratings();
+            m_rated_roles = roles;
+            m_role_ratings_dirty = false;
+            LOGI << "calculated roles in" << t.elapsed() << "ms";
+        }
 
 
         t.restart();
@@ -486,41 +952,141 @@ void DFInstance::load_population_data(){
     DwarfStats::set_max_unit_kills(max_kills);
 }
 
-void DFInstance::load_role_ratings(){
-    if(m_labor_capable_dwarves.size() <= 0)
-        return;
-
-    QVector<double> attribute_values;
-    QVector<double> attribute_raw_values;
-    QVector<double> skill_values;
-    QVector<double> trait_values;
-    QVector<double> pref_values;
+//! the values a unit adds to the population's rating distributions
+struct role_stat_values {
+    QVector<double> attributes;
+    QVector<double> attributes_raw;
+    QVector<double> skills;
+    QVector<double> traits;
+};
+
+//! everything the steps of the role ratings share
+struct role_rating_job {
+    QVector<Dwarf*> units;
+    RoleMatrix *matrix;
+    QList<ATTRIBUTES_TYPE> attribute_ids;
+    QList<int> skill_ids;
+    QVector<role_stat_values> values; // per unit, merged in unit order afterwards
+    bool show_custom;
+};
+
+//! runs one step of the role ratings for a slice of the units, each unit only writes its own slots
+class RoleRatingTask : public QRunnable {
+public:
+    enum STEP {
+        COLLECT, // distribution values and preference matches
+        RATE, // raw ratings of the roles without scripts, needs DwarfStats
+        DISPLAY // display ratings, needs the scripted roles and the role stats
+    };
+
+    RoleRatingTask(STEP step, role_rating_job *job, int start, int count)
+        : m_step(step)
+        , m_job(job)
+        , m_start(start)
+        , m_count(count)
+    {}
+
+    void run() {
+        for (int i = m_start; i < m_start + m_count; ++i) {
+            Dwarf *d = m_job->units.at(i);
+            switch (m_step) {
+            case COLLECT:
+                collect(d, m_job->values[i]);
+                m_job->matrix->load_preferences(i, d);
+                break;
+            case RATE:
+                m_job->matrix->rate(i, d);
+                break;
+            case DISPLAY:
+                d->set_raw_role_ratings(m_job->matrix->roles(), m_job->matrix->ratings(i));
+                d->refresh_role_display_ratings(m_job->show_custom);
+                break;
+            }
+        }
+    }
 
-    GameDataReader *gdr = GameDataReader::ptr();
+private:
+    STEP m_step;
+    role_rating_job *m_job;
+    int m_start;
+    int m_count;
 
-    foreach(Dwarf *d, m_labor_capable_dwarves){
-        foreach(ATTRIBUTES_TYPE id, gdr->get_attributes().keys()){
-            attribute_values.append(d->get_attribute(id).get_balanced_value());
-            attribute_raw_values.append(d->get_attribute(id).get_value());
+    void collect(Dwarf *d, role_stat_values &v) {
+        foreach(ATTRIBUTES_TYPE id, m_job->attribute_ids){
+            Attribute a = d->get_attribute(id);
+            v.attributes.append(a.get_balanced_value());
+            v.attributes_raw.append(a.get_value());
         }
-
-        foreach(int id, gdr->get_skills().keys()){
-            skill_values.append(d->get_skill(id).get_balanced_level());
+        foreach(int id, m_job->skill_ids){
+            v.skills.append(d->get_skill(id).get_balanced_level());
         }
-
         foreach(short val, d->get_traits()->values()){
-            trait_values.append((double)val);
+            v.traits.append((double)val);
         }
+    }
+};
 
-        foreach(Role *r, gdr->get_roles().values()){
-            if(r->prefs.count() > 0){
-                pref_values.append(d->get_role_pref_match_counts(r,true));
-            }
-        }
+//! runs a step for every unit on the pool, or on this thread without one
+static void run_role_rating_step(QThreadPool *pool, RoleRatingTask::STEP step, role_rating_job *job){
+    int count = job->units.count();
+    if(!pool){
+        RoleRatingTask(step, job, 0, count).run();
+        return;
     }
+    int slices = qMax(1, pool->maxThreadCount() * 4);
+    int slice_size = qMax(1, (count + slices - 1) / slices);
+    for(int start = 0; start < count; start += slice_size){
+        pool->start(new RoleRatingTask(step, job, start, qMin(slice_size, count - start)));
+    }
+    pool->waitForDone();
+}
+
+void DFInstance::load_role_ratings(){
+    if(m_labor_capable_dwarves.size() <= 0)
+        return;
+
+    GameDataReader *gdr = GameDataReader::ptr();
+    RoleMatrix matrix(gdr->get_roles().values());
+
+    role_rating_job job;
+    job.units = m_labor_capable_dwarves;
+    job.matrix = &matrix;
+    job.attribute_ids = gdr->get_attributes().keys();
+    job.skill_ids = gdr->get_skills().keys();
+    job.values.resize(job.units.count());
+    job.show_custom = DT->user_settings()->value("options/show_custom_roles",false).toBool();
+    matrix.resize(job.units.count());
+
+    //castes load their skill rates on first use, do that here rather than racing on a worker
+    foreach(Dwarf *d, job.units){
+        if(d->get_caste())
+            d->get_caste()->load_skill_rates();
+    }
+
+    //every unit is rated on its own into its own slots, so any number of threads gives the same result
+    int threads = DT->user_settings()->value("options/role_rating_threads", 0).toInt();
+    QThreadPool pool;
+    if(threads > 0)
+        pool.setMaxThreadCount(threads);
+    QThreadPool *workers = (threads == 1 ? 0 : &pool);
 
     QTime tr;
     tr.start();
+    run_role_rating_step(workers, RoleRatingTask::COLLECT, &job);
+
+    QVector<double> attribute_values;
+    QVector<double> attribute_raw_values;
+    QVector<double> skill_values;
+    QVector<double> trait_values;
+    foreach(const role_stat_values &v, job.values){
+        attribute_values << v.attributes;
+        attribute_raw_values << v.attributes_raw;
+        skill_values << v.skills;
+        trait_values << v.traits;
+    }
+    job.values.clear();
+    LOGV << "     - collected role data in" << tr.elapsed() << "ms";
+
     LOGV << "Role Trait Info:";
     DwarfStats::init_traits(trait_values);
     LOGV << "     - loaded trait role data in" << tr.elapsed() << "ms";
@@ -534,23 +1100,29 @@ void DFInstance::load_role_ratings(){
     LOGV << "     - loaded attribute role data in" << tr.elapsed() << "ms";
 
     LOGV << "Role Preferences Info:";
-    DwarfStats::init_prefs(pref_values);
+    DwarfStats::init_prefs(matrix.preference_values());
     LOGV << "     - loaded preference role data in" << tr.elapsed() << "ms";
 
     float role_rating_avg = 0;
 
-    QVector<double> all_role_ratings;
-    foreach(Dwarf *d, m_labor_capable_dwarves){
-        foreach(double rating, d->calc_role_ratings()){
-            all_role_ratings.append(rating);
-            role_rating_avg+=rating;
+    int rate_start = tr.elapsed();
+    run_role_rating_step(workers, RoleRatingTask::RATE, &job);
+    //scripts run in the GUI thread's script engine
+    if(matrix.has_scripted()){
+        for(int i = 0; i < job.units.count(); i++){
+            matrix.rate_scripted(i, job.units.at(i));
         }
+        RoleScriptEngine::log_timings();
+    }
+    QVector<double> all_role_ratings = matrix.all_ratings();
+    foreach(double rating, all_role_ratings){
+        role_rating_avg+=rating;
     }
+    LOGD << "rated" << matrix.roles().count() << "roles for" << job.units.count() << "units in" << tr.elapsed() - rate_start
+         << "ms on" << (workers ? workers->maxThreadCount() : 1) << "threads";
     LOGV << "Role Display Info:";
     DwarfStats::init_roles(all_role_ratings);
-    foreach(Dwarf *d, m_labor_capable_dwarves){
-        d->refresh_role_display_ratings();
-    }
+    run_role_rating_step(workers, RoleRatingTask::DISPLAY, &job);
     LOGV << "     - loaded role display data in" << tr.elapsed() << "ms";
 
     float max = 0;
@@ -589,6 +1161,12 @@ void DFInstance::load_reactions(){
     detach();
 }
 
+//! packs a material name lookup into the key of the material name memo
+static quint64 material_name_key(int mat_index, short mat_type, ITEM_TYPE itype, MATERIAL_STATES mat_state){
+    return (quint64)(quint32)mat_index << 32 | (quint64)(quint16)mat_type << 16
+            | (quint64)((itype + 1) & 0xfff) << 4 | (mat_state & 0xf);
+}
+
 void DFInstance::load_main_vectors(){
     //material templates
     LOGD << "reading material templates";
@@ -658,6 +1236,22 @@ void DFInstance::load_main_vectors(){
         m_plants_vector.append(p);
         i++;
     }
+
+    // most preferences and uniforms name inorganic and plant materials, so resolve those up front
+    m_material_names.clear();
+    for(i = 0; i < m_inorganics_vector.count(); i++){
+        QString name = resolve_material_name(i, 0, NONE, SOLID);
+        if(!name.isEmpty())
+            m_material_names.insert(material_name_key(i, 0, NONE, SOLID), name);
+    }
+    for(i = 0; i < m_plants_vector.count(); i++){
+        for(int idx = 0; idx < m_plants_vector.at(i)->material_count(); idx++){
+            QString name = resolve_material_name(i, 419 + idx, NONE, SOLID);
+            if(!name.isEmpty())
+                m_material_names.insert(material_name_key(i, 419 + idx, NONE, SOLID), name);
+        }
+    }
+    LOGD << "resolved" << m_material_names.count() << "material names";
 }
 
 ItemWeaponSubtype *DFInstance::find_weapon_subtype(QString name){
@@ -735,6 +1329,20 @@ const QString DFInstance::fortress_name(){
 }
 
 void DFInstance::refresh_data(){
+    invalidate_cache();
+    bool session = reads_stop_process();
+    if(session)
+        attach();
+
+    // figures are added as the world ages, so forget the ones that weren't found
+    m_histfig_search = DT->user_settings()->value("options/histfig_binary_search", true).toBool();
+    m_histfig_cache.clear();
+    m_histfig_cache.setMaxCost(qMax(1, DT->user_settings()->value("options/histfig_cache_size", 4096).toInt()));
+    m_event_cache.clear();
+    m_fake_identities.clear();
+    m_identities_loaded = false;
+    m_event_cache.setMaxCost(qMax(1, DT->user_settings()->value("options/event_cache_size", 4096).toInt()));
+
     VPTR current_year = m_layout->address("current_year");
     LOGD << "loading current year from" << hexify(current_year);
 
@@ -749,32 +1357,64 @@ void DFInstance::refresh_data(){
     load_fortress();
     load_squads();
     load_items();
+    if(session)
+        detach();
 }
 
 void DFInstance::load_items(){
     LOGD << "loading items";
-    m_mapped_items.clear();
     m_items_vectors.clear();
+    //forget the items that weren't found or asked for on the last refresh,
+    //every other one located so far needs to be checked again
+    for(QHash<ITEM_TYPE, QHash<int, item_location> >::iterator type = m_item_locations.begin(); type != m_item_locations.end(); ++type){
+        QHash<int, item_location>::iterator it = type->begin();
+        while(it != type->end()){
+            if(!it->addr || it->generation != m_items_generation)
+                it = type->erase(it);
+            else
+                ++it;
+        }
+    }
+    m_items_generation++;
 
     //these item vectors appear to contain unclaimed items!
     //load actual weapons and armor
-    m_items_vectors.insert(WEAPON,enumerate_vector(m_layout->address("weapons_vector")));
-    m_items_vectors.insert(SHIELD,enumerate_vector(m_layout->address("shields_vector")));
-    m_items_vectors.insert(PANTS,enumerate_vector(m_layout->address("pants_vector")));
-    m_items_vectors.insert(ARMOR,enumerate_vector(m_layout->address("armor_vector")));
-    m_items_vectors.insert(SHOES,enumerate_vector(m_layout->address("shoes_vector")));
-    m_items_vectors.insert(HELM,enumerate_vector(m_layout->address("helms_vector")));
-    m_items_vectors.insert(GLOVES,enumerate_vector(m_layout->address("gloves_vector")));
+    m_items_vectors.insert(WEAPON,m_layout->address("weapons_vector"));
+    m_items_vectors.insert(SHIELD,m_layout->address("shields_vector"));
+    m_items_vectors.insert(PANTS,m_layout->address("pants_vector"));
+    m_items_vectors.insert(ARMOR,m_layout->address("armor_vector"));
+    m_items_vectors.insert(SHOES,m_layout->address("shoes_vector"));
+    m_items_vectors.insert(HELM,m_layout->address("helms_vector"));
+    m_items_vectors.insert(GLOVES,m_layout->address("gloves_vector"));
 
     //load other equipment
-    m_items_vectors.insert(QUIVER,enumerate_vector(m_layout->address("quivers_vector")));
-    m_items_vectors.insert(BACKPACK,enumerate_vector(m_layout->address("backpacks_vector")));
-    m_items_vectors.insert(CRUTCH,enumerate_vector(m_layout->address("crutches_vector")));
-    m_items_vectors.insert(FLASK,enumerate_vector(m_layout->address("flasks_vector")));
-    m_items_vectors.insert(AMMO,enumerate_vector(m_layout->address("ammo_vector")));
+    m_items_vectors.insert(QUIVER,m_layout->address("quivers_vector"));
+    m_items_vectors.insert(BACKPACK,m_layout->address("backpacks_vector"));
+    m_items_vectors.insert(CRUTCH,m_layout->address("crutches_vector"));
+    m_items_vectors.insert(FLASK,m_layout->address("flasks_vector"));
+    m_items_vectors.insert(AMMO,m_layout->address("ammo_vector"));
 
     //load artifacts
-    m_items_vectors.insert(ARTIFACTS,enumerate_vector(m_layout->address("artifacts_vector")));
+    m_items_vectors.insert(ARTIFACTS,m_layout->address("artifacts_vector"));
+
+    //locate everything the squad uniforms refer to in one go
+    QHash<ITEM_TYPE, QVector<int> > uniform_items;
+    foreach(Squad *s, m_squads){
+        foreach(Uniform *u, s->get_uniforms()){
+            if(!u)
+                continue;
+            QHash<ITEM_TYPE,QList<ItemDefUniform*> > items = u->get_uniform();
+            foreach(ITEM_TYPE itype, items.keys()){
+                foreach(ItemDefUniform *item_def, items.value(itype)){
+                    if(item_def->id() > 0)
+                        uniform_items[itype].append(item_def->id());
+                }
+            }
+        }
+    }
+    foreach(ITEM_TYPE itype, uniform_items.keys()){
+        prefetch_items(itype, uniform_items.value(itype));
+    }
 }
 
 void DFInstance::load_fortress(){
@@ -865,11 +1505,36 @@ Squad* DFInstance::get_squad(int id){
 
 
 void DFInstance::heartbeat() {
-    // simple read attempt that will fail if the DF game isn't running a fort, or isn't running at all
-    // it would be nice to find a less cumbersome read, but for now at least we know this works
-    if(m_status != DFS_DISCONNECTED && get_creatures(false).size() < 1){
+    if(m_status == DFS_DISCONNECTED || m_prefetching_units)
+        return;
+    invalidate_cache();
+
+    // probe the bounds of the unit vectors rather than enumerating them, both are
+    // empty when DF isn't running a fort, and reads fail when it isn't running at all
+    QByteArray units(4 * sizeof(VPTR), 0);
+    read_raw(m_layout->address("active_creature_vector"), 2 * sizeof(VPTR), units.data());
+    read_raw(m_layout->address("creature_vector"), 2 * sizeof(VPTR), units.data() + 2 * sizeof(VPTR));
+    const VPTR *bounds = reinterpret_cast<const VPTR *>(units.constData());
+    if(bounds[0] == bounds[1] && bounds[2] == bounds[3]){
+        if(m_status == DFS_GAME_LOADED)
+            emit game_unloaded();
+        m_probe_units.clear();
         send_connection_interrupted();
+        return;
     }
+    // a fort loaded after the last one was unloaded still needs a reconnect
+    if(m_status != DFS_GAME_LOADED)
+        return;
+
+    quint32 time = read_word(m_layout->address("current_year")) * ticks_per_year + read_int(m_layout->address("cur_year_tick"));
+    if(time != m_probe_time){
+        m_probe_time = time;
+        emit game_ticked(time - m_cur_time);
+    }
+    if(!m_probe_units.isEmpty() && units != m_probe_units){
+        emit units_changed();
+    }
+    m_probe_units = units;
 }
 
 void DFInstance::send_connection_interrupted(){
@@ -895,7 +1560,7 @@ QVector<VPTR> DFInstance::get_creatures(bool report_progress){
         entries = enumerate_vector(all_units);
     }else{
         //there are active units, but are they ours?
-        int civ_offset = m_layout->dwarf_offset("civ");
+        int civ_offset = m_layout->dwarf_offset(MemoryLayout::DWARF_CIV);
         foreach(VPTR entry, entries){
             if(read_int(entry + civ_offset)==m_dwarf_civ_id){
                 if(report_progress){
@@ -1030,6 +1695,11 @@ void DFInstance::set_memory_layout(QString checksum){
     }
 
     LOGI << "Setting memory layout for DF checksum" << checksum;
+
+    int cache_mb = qBound(0, DT->user_settings()->value("options/page_cache_mb", 16).toInt(), 1024);
+    m_page_cache.setMaxCost(cache_mb * 1024 * 1024);
+    invalidate_cache();
+    refresh_memory_regions();
     m_layout = get_memory_layout(checksum);
 
     if(m_layout && m_layout->is_valid() && m_layout->is_complete()){
@@ -1038,8 +1708,8 @@ void DFInstance::set_memory_layout(QString checksum){
              << m_layout->game_version() << "using MemoryLayout from"
              << m_layout->filepath();
 
-        //call the heartbeat immediately to check for a loaded game
-        heartbeat();
+        //check for a loaded game right away, get_creatures marks it as loaded
+        get_creatures(false);
 
         if(!m_heartbeat_timer->isActive()) {
             m_heartbeat_timer->start(1000); // check every second for disconnection
@@ -1174,36 +1844,171 @@ const QStringList DFInstance::status_err_msg(){
 }
 
 VPTR DFInstance::find_historical_figure(int hist_id){
-    if(m_hist_figures.count() <= 0)
-        load_hist_figures();
+    if(!m_histfig_search){
+        if(m_hist_figures.count() <= 0)
+            load_hist_figures();
+        return m_hist_figures.value(hist_id,0);
+    }
 
-    return m_hist_figures.value(hist_id,0);
+    VPTR *fig = m_histfig_cache.object(hist_id);
+    if(!fig){
+        prefetch_historical_figures(QVector<int>(1, hist_id));
+        fig = m_histfig_cache.object(hist_id);
+    }
+    return fig ? *fig : 0;
 }
 
-void DFInstance::load_hist_figures(){
-    QVector<VPTR> hist_figs = enumerate_vector(m_layout->address("historical_figures_vector"));
-    foreach(VPTR fig, hist_figs){
-        m_hist_figures.insert(read_int(fig + m_layout->hist_figure_offset("id")),fig);
+void DFInstance::prefetch_historical_figures(QVector<int> ids){
+    if(!m_histfig_search)
+        return;
+
+    QVector<int> missing;
+    foreach(int id, ids){
+        if(!m_histfig_cache.contains(id))
+            missing.append(id);
+    }
+    if(missing.isEmpty())
+        return;
+
+    QHash<int, VPTR> found = search_sorted_vector(m_layout->address("historical_figures_vector"),
+                                                  m_layout->hist_figure_offset(MemoryLayout::HF_ID), missing);
+    foreach(int id, missing){
+        m_histfig_cache.insert(id, new VPTR(found.value(id, 0)));
     }
 }
 
-QPair<int,QString> DFInstance::find_activity(int histfig_id){
-    QMapIterator<int,QPointer<Activity> > it(m_activities);
-    it.toBack();
-    while(it.hasPrevious()){
-        it.previous();
-        QPair<int,QString> ret = it.value()->find_activity(histfig_id);
-        if(ret.first != DwarfJob::JOB_UNKNOWN){
-            return ret;
+void DFInstance::prefetch_kill_events(const QVector<int> &hist_ids){
+    if(!m_histfig_search)
+        return;
+
+    // anything past the size of the cache would evict the first events before the units
+    // read them, so stop there and leave the rest to find_event
+    QVector<int> evt_ids;
+    foreach(int hist_id, hist_ids){
+        if(evt_ids.count() >= m_event_cache.maxCost())
+            break;
+        VPTR fig = find_historical_figure(hist_id);
+        if(!fig)
+            continue;
+        VPTR fig_info = read_addr(fig + m_layout->hist_figure_offset(MemoryLayout::HF_HIST_FIG_INFO));
+        VPTR kills = fig_info ? read_addr(fig_info + m_layout->hist_figure_offset(MemoryLayout::HF_KILLS)) : 0;
+        if(kills){
+            foreach(qint32 evt_id, enum_vec<qint32>(kills)){
+                evt_ids.append(evt_id);
+            }
+        }
+    }
+    evt_ids.resize(qMin(evt_ids.count(), m_event_cache.maxCost()));
+    prefetch_events(evt_ids);
+}
+
+QHash<int, VPTR> DFInstance::search_sorted_vector(VPTR vector, VPTRDIFF id_offset, QVector<int> ids){
+    QHash<int, VPTR> found;
+    VPTR start = read_addr(vector);
+    VPTR end = read_addr(vector + sizeof(VPTR));
+    int count = end > start ? (end - start) / sizeof(VPTR) : 0;
+    if(count == 0)
+        return found;
+
+    struct search {
+        int id;
+        int lo;
+        int hi;
+    };
+    QVector<search> pending;
+    qSort(ids);
+    for(int i = 0; i < ids.count(); i++){
+        if(ids.at(i) >= 0 && (i == 0 || ids.at(i) != ids.at(i-1))){
+            search s = {ids.at(i), 0, count - 1};
+            pending.append(s);
         }
     }
-    return qMakePair<int,QString>(DwarfJob::JOB_UNKNOWN,"");
+
+    // binary search for every id in lockstep, reading the entries probed by each
+    // step in two batches: the pointers, then the ids they point to
+    QVector<VPTR> entries;
+    QVector<qint32> entry_ids;
+    ReadBatch batch;
+    while(!pending.isEmpty()){
+        entries.fill(0, pending.count());
+        batch.clear();
+        for(int i = 0; i < pending.count(); i++){
+            int mid = (pending.at(i).lo + pending.at(i).hi) / 2;
+            batch.add(start + mid * sizeof(VPTR), entries[i]);
+        }
+        read_batch(batch);
+
+        entry_ids.fill(-1, pending.count());
+        batch.clear();
+        for(int i = 0; i < pending.count(); i++){
+            if(entries.at(i))
+                batch.add(entries.at(i) + id_offset, entry_ids[i]);
+        }
+        read_batch(batch);
+
+        QVector<search> next;
+        for(int i = 0; i < pending.count(); i++){
+            search s = pending.at(i);
+            int mid = (s.lo + s.hi) / 2;
+            if(!entries.at(i))
+                continue;
+            if(entry_ids.at(i) == s.id){
+                found.insert(s.id, entries.at(i));
+                continue;
+            }
+            if(entry_ids.at(i) < s.id)
+                s.lo = mid + 1;
+            else
+                s.hi = mid - 1;
+            if(s.lo <= s.hi)
+                next.append(s);
+        }
+        pending = next;
+    }
+    return found;
+}
+
+void DFInstance::load_hist_figures(){
+    m_hist_figures = index_vector(m_layout->address("historical_figures_vector"), m_layout->hist_figure_offset(MemoryLayout::HF_ID));
+}
+
+QHash<int, VPTR> DFInstance::index_vector(VPTR vector, VPTRDIFF id_offset){
+    QVector<VPTR> entries = enumerate_vector(vector);
+    QVector<qint32> ids(entries.count(), -1);
+    ReadBatch batch;
+    for(int i = 0; i < entries.count(); i++){
+        batch.add(entries.at(i) + id_offset, ids[i]);
+    }
+    read_batch(batch);
+
+    QHash<int, VPTR> index;
+    index.reserve(entries.count());
+    for(int i = 0; i < entries.count(); i++){
+        index.insert(ids.at(i), entries.at(i));
+    }
+    return index;
+}
+
+QPair<int,QString> DFInstance::find_activity(int histfig_id){
+    return m_activity_index.value(histfig_id, qMakePair<int,QString>(DwarfJob::JOB_UNKNOWN,""));
 }
 
 void DFInstance::load_activities(){
     qDeleteAll(m_activities);
     m_activities.clear();
+    m_activity_index.clear();
     LOGD << "loading activities";
+
+    //only decode the participants that are one of the units
+    QVector<VPTR> units = enumerate_vector(m_layout->address("creature_vector"));
+    QVector<qint32> unit_hist_ids(units.count(), -1);
+    ReadBatch batch;
+    for(int i = 0; i < units.count(); i++){
+        batch.add(units.at(i) + m_layout->dwarf_offset(MemoryLayout::DWARF_HIST_ID), unit_hist_ids[i]);
+    }
+    read_batch(batch);
+    QSet<int> unit_figs = unit_hist_ids.toList().toSet();
+
     QVector<VPTR> activity_addrs = enumerate_vector(m_layout->address("activities_vector"));
     QMap<int,VPTR> sorted_activities;
     foreach(VPTR addr, activity_addrs){
@@ -1214,9 +2019,16 @@ void DFInstance::load_activities(){
     it.toBack();
     while(it.hasPrevious()){
         it.previous();
-        QPointer<Activity> act = new Activity(this,it.value(),this);
+        QPointer<Activity> act = new Activity(this,it.value(),&unit_figs,this);
         if(act->activity_count() > 0){
             m_activities.insert(it.key(), act);
+            //newest activities come first, and they take precedence
+            QHashIterator<int, QPair<int,QString> > actions(act->histfig_actions());
+            while(actions.hasNext()){
+                actions.next();
+                if(!m_activity_index.contains(actions.key()))
+                    m_activity_index.insert(actions.key(), actions.value());
+            }
         }
     }
 }
@@ -1226,32 +2038,41 @@ VPTR DFInstance::find_occupation(int hist_id){
 }
 
 void DFInstance::load_occupations(){
-    QVector<VPTR> oc_addrs = enumerate_vector(m_layout->address("occupations_vector"));
-    foreach(VPTR addr, oc_addrs){
-        m_occupations.insert(read_int(addr + 0x8),addr);
-    }
+    m_occupations = index_vector(m_layout->address("occupations_vector"), 0x8);
 }
 
 VPTR DFInstance::find_identity(int id){
-    if(m_fake_identities.count() == 0) //lazy load fake identities
-        m_fake_identities = enumerate_vector(m_layout->address("fake_identities_vector"));
-    foreach(VPTR ident, m_fake_identities){
-        int fake_id = read_int(ident);
-        if(fake_id==id){
-            return ident;
-        }
+    if(!m_identities_loaded){ //lazy load fake identities, once per refresh
+        m_fake_identities = index_vector(m_layout->address("fake_identities_vector"), 0);
+        m_identities_loaded = true;
     }
-    return 0;
+    return m_fake_identities.value(id,0);
 }
 
 VPTR DFInstance::find_event(int id){
-    if(m_events.count() == 0){
-        QVector<VPTR> all_events_addrs = enumerate_vector(m_layout->address("events_vector"));
-        foreach(VPTR evt_addr, all_events_addrs){
-            m_events.insert(read_int(evt_addr+m_layout->hist_event_offset("id")),evt_addr);
-        }
+    VPTR *evt = m_event_cache.object(id);
+    if(!evt){
+        prefetch_events(QVector<int>(1, id));
+        evt = m_event_cache.object(id);
+    }
+    return evt ? *evt : 0;
+}
+
+void DFInstance::prefetch_events(QVector<int> ids){
+    QVector<int> missing;
+    foreach(int id, ids){
+        if(!m_event_cache.contains(id))
+            missing.append(id);
+    }
+    if(missing.isEmpty())
+        return;
+
+    // the events vector is sorted by id, and far too large to index
+    QHash<int, VPTR> found = search_sorted_vector(m_layout->address("events_vector"),
+                                                  m_layout->hist_event_offset("id"), missing);
+    foreach(int id, missing){
+        m_event_cache.insert(id, new VPTR(found.value(id, 0)));
     }
-    return m_events.value(id,0);
 }
 
 QVector<VPTR> DFInstance::get_itemdef_vector(ITEM_TYPE i){
@@ -1278,21 +2099,60 @@ QString DFInstance::get_preference_item_name(int index, int subtype){
 }
 
 VPTR DFInstance::get_item_address(ITEM_TYPE itype, int item_id){
-    if(m_mapped_items.value(itype).count() <= 0)
-        index_item_vector(itype);
-    if(m_mapped_items.contains(itype)){
-        if(m_mapped_items.value(itype).contains(item_id))
-            return m_mapped_items.value(itype).value(item_id);
+    QHash<int, item_location> &locations = m_item_locations[itype];
+    QHash<int, item_location>::iterator it = locations.find(item_id);
+    if(it == locations.end() || it->generation != m_items_generation){
+        prefetch_items(itype, QVector<int>(1, item_id));
+        it = locations.find(item_id);
     }
-    return 0;
+    return it != locations.end() ? it->addr : 0;
 }
 
-QString DFInstance::get_artifact_name(ITEM_TYPE itype, int item_id){
-    if(m_mapped_items.value(itype).count() <= 0)
-        index_item_vector(itype);
+void DFInstance::prefetch_items(ITEM_TYPE itype, const QVector<int> &item_ids){
+    if(!m_items_vectors.contains(itype))
+        return;
+    QHash<int, item_location> &locations = m_item_locations[itype];
+    VPTRDIFF id_offset = item_id_offset(itype);
+
+    //items found on an earlier refresh are usually still there, so check their ids first
+    QVector<int> stale;
+    QVector<int> missing;
+    foreach(int id, item_ids){
+        QHash<int, item_location>::const_iterator it = locations.constFind(id);
+        if(it == locations.constEnd() || !it->addr){
+            missing.append(id);
+        }else if(it->generation != m_items_generation){
+            stale.append(id);
+        }
+    }
+    QVector<qint32> stale_ids(stale.count(), -1);
+    ReadBatch batch;
+    for(int i = 0; i < stale.count(); i++){
+        batch.add(locations.value(stale.at(i)).addr + id_offset, stale_ids[i]);
+    }
+    read_batch(batch);
+    for(int i = 0; i < stale.count(); i++){
+        if(stale_ids.at(i) == stale.at(i)){
+            locations[stale.at(i)].generation = m_items_generation;
+        }else{
+            locations.remove(stale.at(i));
+            missing.append(stale.at(i));
+        }
+    }
 
+    //the rest are searched for, remembering the ones that don't exist for this refresh only
+    if(missing.isEmpty())
+        return;
+    QHash<int, VPTR> found = search_sorted_vector(m_items_vectors.value(itype), id_offset, missing);
+    foreach(int id, missing){
+        item_location loc = {found.value(id, 0), m_items_generation};
+        locations.insert(id, loc);
+    }
+}
+
+QString DFInstance::get_artifact_name(ITEM_TYPE itype, int item_id){
     if(itype == ARTIFACTS){
-        VPTR addr = m_mapped_items.value(itype).value(item_id);
+        VPTR addr = get_item_address(itype, item_id);
         if(addr){
             QString name = get_language_word(addr+0x4); //TODO: offset
             if(name.isEmpty()){
@@ -1307,18 +2167,6 @@ QString DFInstance::get_artifact_name(ITEM_TYPE itype, int item_id){
     }
 }
 
-void DFInstance::index_item_vector(ITEM_TYPE itype){
-    QHash<int,VPTR> items;
-    int offset = m_layout->item_offset("id");
-    if(itype == ARTIFACTS){
-        offset = 0x0;
-    }
-    foreach(VPTR addr, m_items_vectors.value(itype)){
-        items.insert(read_int(addr+offset),addr);
-    }
-    m_mapped_items.insert(itype,items);
-}
-
 QString DFInstance::get_preference_other_name(int index, PREF_TYPES p_type){
     QVector<VPTR> target_vec;
     int offset = 0x4; //default for poem/music/dance
@@ -1357,6 +2205,21 @@ QString DFInstance::get_preference_other_name(int index, PREF_TYPES p_type){
 }
 
 QString DFInstance::find_material_name(int mat_index, short mat_type, ITEM_TYPE itype, MATERIAL_STATES mat_state){
+    quint64 key = material_name_key(mat_index, mat_type, itype, mat_state);
+    QHash<quint64, QString>::const_iterator it = m_material_names.constFind(key);
+    if (it != m_material_names.constEnd())
+        return it.value();
+
+    QString name = resolve_material_name(mat_index, mat_type, itype, mat_state);
+    if(name.isEmpty()){
+        LOGW << "material name not found!";
+    }else{
+        m_material_names.insert(key, name);
+    }
+    return name;
+}
+
+QString DFInstance::resolve_material_name(int mat_index, short mat_type, ITEM_TYPE itype, MATERIAL_STATES mat_state){
     Material *m = find_material(mat_index, mat_type);
     QString name = "";
 
@@ -1385,10 +2248,10 @@ QString DFInstance::find_material_name(int mat_index, short mat_type, ITEM_TYPE
     {
         VPTR hist_figure = find_historical_figure(mat_index);
         if(hist_figure){
-            Race *r = get_race(read_short(hist_figure + m_layout->hist_figure_offset("hist_race")));
+            Race *r = get_race(read_short(hist_figure + m_layout->hist_figure_offset(MemoryLayout::HF_HIST_RACE)));
             if(r){
                 name = QString(tr("%1's %2"))
-                        .arg(read_string(hist_figure + m_layout->hist_figure_offset("hist_name")))
+                        .arg(read_string(hist_figure + m_layout->hist_figure_offset(MemoryLayout::HF_HIST_NAME)))
                         .arg(m->get_material_name(mat_state));
             }
         }
@@ -1437,9 +2300,6 @@ QString DFInstance::find_material_name(int mat_index, short mat_type, ITEM_TYPE
             }
         }
     }
-    if(name.isEmpty()){
-        LOGW << "material name not found!";
-    }
     return name.toLower().trimmed();
 }
 
@@ -1457,7 +2317,7 @@ Material *DFInstance::find_material(int mat_index, short mat_type){
     } else if (mat_type < 419) {
         VPTR hist_figure = find_historical_figure(mat_index);
         if (hist_figure) {
-            Race *r = get_race(read_short(hist_figure + m_layout->hist_figure_offset("hist_race")));
+            Race *r = get_race(read_short(hist_figure + m_layout->hist_figure_offset(MemoryLayout::HF_HIST_RACE)));
             if (r)
                 return r->get_creature_material(mat_type-219);
         }
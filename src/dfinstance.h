@@ -27,6 +27,7 @@ THE SOFTWARE.
 #include "global_enums.h"
 #include "truncatingfilelogger.h"
 
+#include <QCache>
 #include <QDir>
 #include <QPointer>
 
@@ -95,8 +96,11 @@ public:
             buf = T();
         return buf;
     }
-    virtual size_t read_raw(VPTR addr, size_t bytes, void *buf) = 0;
+    //! read through the page cache; reads larger than a page go straight to the process
+    size_t read_raw(VPTR addr, size_t bytes, void *buf);
     virtual QString read_string(VPTR addr) = 0;
+    //! read many strings at once, in the same order as their addresses
+    virtual QStringList read_strings(const QVector<VPTR> &addrs);
     size_t read_raw(VPTR addr, size_t bytes, QByteArray &buffer);
     quint8 read_byte(VPTR addr);
     quint32 read_word(VPTR addr);
@@ -107,12 +111,20 @@ public:
     QVector<qint16> enumerate_vector_short(VPTR addr);
     template<typename T>
     QVector<T> enum_vec(VPTR addr) {
-        QVector<T> out;
         VPTR start = read_addr(addr);
         VPTR end = read_addr(addr + sizeof(VPTR ));
+        return enum_vec<T>(start, end, addr);
+    }
+    //! read the contents of a vector whose begin/end pointers are already known
+    template<typename T>
+    QVector<T> enum_vec(VPTR start, VPTR end, VPTR addr) {
+        QVector<T> out;
         size_t bytes = end - start;
         if (bytes % sizeof(T)) {
             LOGE << "VECTOR SIZE IS NOT A MULTIPLE OF TYPE";
+        } else if (bytes && !is_valid_address(start, bytes)) {
+            m_rejected_reads++;
+            TRACE << "vector at" << hexify(addr) << "points outside of mapped memory";
         } else {
             out.resize(bytes / sizeof(T));
             size_t bytes_read = read_raw(start, bytes, out.data());
@@ -123,6 +135,59 @@ public:
     Word * read_dwarf_word(VPTR addr);
     QString read_dwarf_name(VPTR addr);
 
+    //! a list of scattered reads (address, size, destination) which can be serviced together
+    class ReadBatch {
+    public:
+        struct request {
+            VPTR addr;
+            size_t bytes;
+            void *buf;
+        };
+        template<typename T> void add(VPTR addr, T &dest) {
+            add_raw(addr, sizeof(T), &dest);
+        }
+        void add_raw(VPTR addr, size_t bytes, void *buf) {
+            request r = {addr, bytes, buf};
+            m_requests.append(r);
+        }
+        const QVector<request> &requests() const {return m_requests;}
+        int count() const {return m_requests.count();}
+        bool isEmpty() const {return m_requests.isEmpty();}
+        void clear() {m_requests.clear();}
+    private:
+        QVector<request> m_requests;
+    };
+    //! read every request in the batch, zero filling any destination that couldn't be read
+    virtual size_t read_batch(const ReadBatch &batch);
+
+    //! false if the range isn't inside a readable mapping (always true if the mappings are unknown)
+    bool is_valid_address(VPTR addr, size_t bytes = 1);
+
+    //! forget every cached page, anything read afterwards comes from the process again
+    void invalidate_cache() {m_cache_generation++;}
+    quint64 cache_hits() const {return m_cache_hits;}
+    quint64 cache_misses() const {return m_cache_misses;}
+
+    //! raw unit and soul structs read ahead of time by the unit load
+    struct unit_prefetch {
+        VPTR addr;
+        QByteArray unit;
+        VPTR soul;
+        QByteArray soul_data;
+    };
+    bool take_prefetched_unit(VPTR addr, QByteArray &data);
+    bool take_prefetched_soul(VPTR addr, VPTR soul, QByteArray &data);
+
+    //! true if read_concurrent may be called from several threads at once
+    virtual bool concurrent_reads() {return false;}
+    //! thread safe read straight from the process, bypassing the page cache, region index and fallbacks
+    virtual size_t read_concurrent(VPTR addr, size_t bytes, void *buf) {Q_UNUSED(addr); memset(buf, 0, bytes); return 0;}
+
+    //! capture every page read from now on, so they can be saved for DFInstanceSnapshot
+    void start_recording(const QString &path);
+    //! write the recorded pages to the snapshot file and stop recording
+    bool finish_recording();
+
     QString pprint(const QByteArray &ba);
 
     // Memory layouts
@@ -133,12 +198,14 @@ public:
     bool add_new_layout(const QString & filename, const QString data, QString &result_msg);
 
     // Writing
-    virtual size_t write_raw(VPTR addr, size_t bytes, const void *buffer) = 0;
+    size_t write_raw(VPTR addr, size_t bytes, const void *buffer);
     size_t write_raw(VPTR addr, size_t bytes, const QByteArray &buffer);
     virtual size_t write_string(VPTR addr, const QString &str) = 0;
     size_t write_int(VPTR addr, int val);
 
     bool is_attached() {return m_attach_count > 0;}
+    //! true when every read has to stop the process, long loads then attach once up front
+    virtual bool reads_stop_process() {return false;}
     virtual bool attach() = 0;
     virtual bool detach() = 0;
     virtual int VM_TYPE_OFFSET() {return 0x1;}
@@ -152,7 +219,10 @@ public:
     void load_game_data();
     void read_raws();
 
-    QVector<Dwarf*> load_dwarves();
+    //! reads the units, reusing those in previous whose fingerprint hasn't changed since the last read
+    QVector<Dwarf*> load_dwarves(const QHash<int, Dwarf*> &previous = QHash<int, Dwarf*>());
+    //! forces the unit at addr to be read again on the next load_dwarves
+    void expire_unit(VPTR addr) {m_unit_fingerprints.remove(addr);}
     void load_reactions();
     void load_races_castes();
     void load_main_vectors();
@@ -185,8 +255,13 @@ public:
     QVector<Race *> get_races() {return m_races;}
 
     VPTR find_historical_figure(int hist_id);
+    //! resolves many figures at once, so later find_historical_figure calls are cache hits
+    void prefetch_historical_figures(QVector<int> ids);
+    //! resolves the kill events of the given figures, so reading their kills is all cache hits
+    void prefetch_kill_events(const QVector<int> &hist_ids);
     VPTR find_identity(int id);
     VPTR find_event(int id);
+    void prefetch_events(QVector<int> ids);
     QPair<int, QString> find_activity(int histfig_id);
     VPTR find_occupation(int histfig_id);
 
@@ -221,6 +296,8 @@ public:
 
     QVector<VPTR> get_itemdef_vector(ITEM_TYPE i);
     VPTR get_item_address(ITEM_TYPE itype, int item_id);
+    //! locates many items of one type at once, so later get_item_address calls are cache hits
+    void prefetch_items(ITEM_TYPE itype, const QVector<int> &item_ids);
 
     QString get_preference_item_name(int index, int subtype);
     QString get_preference_other_name(int index, PREF_TYPES p_type);
@@ -262,6 +339,19 @@ protected:
 
     virtual bool set_pid() = 0;
 
+    // platform specific access to the process' memory, bypassing the page cache
+    virtual size_t read_process_memory(VPTR addr, size_t bytes, void *buf) = 0;
+    virtual size_t write_process_memory(VPTR addr, size_t bytes, const void *buffer) = 0;
+
+    //! fill in the readable mappings of the process (start->end), false if they can't be listed
+    virtual bool load_memory_regions(QMap<quintptr, quintptr> &regions) {Q_UNUSED(regions); return false;}
+    void refresh_memory_regions();
+
+    static const quint32 snapshot_magic = 0x44545350; // "DTSP"
+    static const quint32 snapshot_version = 1;
+    //! true while a snapshot is recorded, reads are then served from the captured pages
+    bool recording() const {return m_recording;}
+
     void load_population_data();
     void load_role_ratings();
     bool check_vector(VPTR start, VPTR end, VPTR addr);
@@ -282,6 +372,8 @@ protected:
 
 private slots:
     void heartbeat();
+    void reset_unit_fingerprints();
+    void roles_changed();
 
 signals:
     // methods for sending progress information to QWidgets
@@ -289,6 +381,10 @@ signals:
     void progress_message(const QString &message);
     void progress_range(int min, int max);
     void progress_value(int value);
+    // results of the heartbeat probe
+    void game_unloaded();
+    void game_ticked(int ticks_stale);
+    void units_changed();
 
 private:
     Languages* m_languages;
@@ -301,18 +397,58 @@ private:
     QVector<Plant *> m_plants_vector;
     QVector<Material *> m_inorganics_vector;
     QVector<Material *> m_base_materials;
+    //! names already resolved by find_material_name, kept until the raws are loaded again
+    QHash<quint64, QString> m_material_names;
+    QString resolve_material_name(int mat_index, short mat_type, ITEM_TYPE itype, MATERIAL_STATES mat_state);
 
     QVector<VPTR> get_creatures(bool report_progress = true);
 
+    static const size_t remote_page_size = 4096;
+    struct remote_page {
+        quint32 generation;
+        char data[remote_page_size];
+    };
+    //! LRU of remote pages keyed by page address, the cost of each entry is its size in bytes
+    QCache<quintptr, remote_page> m_page_cache;
+    quint32 m_cache_generation;
+    quint64 m_cache_hits;
+    quint64 m_cache_misses;
+    const char *cached_page(quintptr page);
+
+    QMap<quintptr, quintptr> m_regions;
+    bool m_regions_known;
+    quint32 m_regions_generation;
+    quint64 m_rejected_reads;
+    bool region_contains(quintptr start, size_t bytes) const;
+
+    bool m_recording;
+    QString m_record_path;
+    QMap<quintptr, QByteArray> m_recorded_pages; // page -> contents when first read, empty if unreadable
+    size_t read_recorded(VPTR addr, size_t bytes, void *buf);
+
     QHash<int,VPTR> m_hist_figures;
-    QVector<VPTR> m_fake_identities;
+    bool m_histfig_search;
+    QCache<int, VPTR> m_histfig_cache; // recently resolved figures (0 if not found)
+    QHash<int,VPTR> m_fake_identities;
+    bool m_identities_loaded;
     QHash<int,VPTR> m_occupations;
-    QHash<int,VPTR> m_events;
+    QCache<int, VPTR> m_event_cache; // recently resolved events (0 if not found)
+    QHash<int, VPTR> search_sorted_vector(VPTR vector, VPTRDIFF id_offset, QVector<int> ids);
+    //! maps the id at id_offset of every entry in the vector to the entry, reading the ids in one batch
+    QHash<int, VPTR> index_vector(VPTR vector, VPTRDIFF id_offset);
     QMap<int,QPointer<Activity> > m_activities;
+    QHash<int, QPair<int,QString> > m_activity_index; //histfig id -> most specific current activity
 
     QHash<ITEM_TYPE, QVector<VPTR> > m_itemdef_vectors;
-    QHash<ITEM_TYPE, QVector<VPTR> > m_items_vectors;
-    QHash<ITEM_TYPE, QHash<int,VPTR> >  m_mapped_items;
+    QHash<ITEM_TYPE, VPTR> m_items_vectors; //global item vectors, sorted by id
+
+    //where an item was found, and the refresh it was last confirmed to still be there
+    struct item_location {
+        VPTR addr;
+        quint32 generation;
+    };
+    QHash<ITEM_TYPE, QHash<int, item_location> > m_item_locations;
+    quint32 m_items_generation;
 
     QVector<VPTR> m_color_vector;
     QVector<VPTR> m_shape_vector;
@@ -334,9 +470,24 @@ private:
     VPTR m_squad_vector;
     QList<Squad*> m_squads;
 
+    QHash<VPTR, unit_prefetch> m_unit_prefetch;
+
+    QHash<VPTR, QByteArray> m_unit_fingerprints; // creature address -> fingerprint when it was last read
+    QSet<VPTR> m_rejected_units; // creatures that failed validation on the last read
+
+    quint32 m_probe_time;
+    QByteArray m_probe_units; // bounds of the unit vectors at the last heartbeat
+    quint32 m_units_year;
+    bool m_prefetching_units; // workers are reading units while the event loop runs
+    bool m_role_ratings_dirty; // roles were edited since the kept units were last rated
+    QStringList m_rated_roles; // names of the roles the kept units were last rated for
+    QByteArray unit_fingerprint(VPTR unit);
+    bool can_prefetch_units();
+    void prefetch_units(const QVector<VPTR> &addrs);
+
     void load_hist_figures();
     void load_occupations();
-    void index_item_vector(ITEM_TYPE itype);
+    VPTRDIFF item_id_offset(ITEM_TYPE itype) {return itype == ARTIFACTS ? 0 : m_layout->item_offset("id");}
     void send_connection_interrupted();
 };
 
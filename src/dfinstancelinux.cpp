@@ -28,21 +28,24 @@ THE SOFTWARE.
 #include <QDirIterator>
 
 #include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
 #include <sys/mman.h>
 #include <sys/ptrace.h>
 #include <sys/syscall.h>
+#include <sys/uio.h>
 #include <sys/user.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
-struct iovec {
-    void *iov_base;
-    size_t iov_len;
-};
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
 
 DFInstanceLinux::DFInstanceLinux(QObject* parent)
     : DFInstanceNix(parent)
-    , m_warned_pvm(false)
+    , m_mem_fd(-1)
+    , m_pvm_unsupported(false)
 {
 }
 
@@ -93,14 +96,18 @@ bool DFInstanceLinux::attach() {
 
 bool DFInstanceLinux::detach() {
     //TRACE << "STARTING DETACH" << m_attach_count;
-    if(m_memory_file.isOpen())
-        m_memory_file.close();
     m_attach_count--;
     if (m_attach_count > 0) {
         TRACE << "NO NEED TO DETACH SKIPPING..." << m_attach_count;
         return true;
     }
 
+    // the memory file is only readable while attached, end the session
+    if (m_mem_fd != -1) {
+        ::close(m_mem_fd);
+        m_mem_fd = -1;
+    }
+
     ptrace(PTRACE_DETACH, m_pid, 0, 0);
     TRACE << "FINISHED DETACH" << m_attach_count;
     return m_attach_count > 0;
@@ -112,43 +119,113 @@ ssize_t DFInstanceLinux::process_vm(long number, const VPTR addr, const size_t b
 
     ssize_t r = syscall(number, m_pid, &local_iov, 1UL, &remote_iov, 1UL, 0UL);
 
-    if (r == -1 && errno == ENOSYS && !m_warned_pvm) {
-        m_warned_pvm = true;
-        LOGI << "Kernel does not support process_vm API, falling back to ptrace.";
-        // reset errno, logger may have modified it
-        errno = ENOSYS;
+    // only a kernel without the syscall is permanent, other failures fall
+    // back to ptrace for that read alone
+    if (r == -1 && errno == ENOSYS)
+        disable_process_vm();
+
+    return r;
+}
+
+void DFInstanceLinux::disable_process_vm() {
+    int err = errno;
+    if (!m_pvm_unsupported) {
+        m_pvm_unsupported = true;
+        LOGI << "process_vm API unavailable (" << QString(strerror(err)) << "), falling back to ptrace.";
     }
+    // reset errno, logger may have modified it
+    errno = err;
+}
+
+bool DFInstanceLinux::open_memory_session() {
+    if (m_mem_fd != -1)
+        return true;
+
+    // can only read once attached and the child is stopped
+    QByteArray path = QString("/proc/%1/mem").arg(m_pid).toLocal8Bit();
+    m_mem_fd = ::open(path.constData(), O_RDONLY);
+    if (m_mem_fd == -1) {
+        LOGE << "Unable to open" << path << QString(strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+ssize_t DFInstanceLinux::process_vm_batch(const struct iovec *local_iov, const struct iovec *remote_iov, unsigned long count) {
+    ssize_t r = syscall(SYS_process_vm_readv, m_pid, local_iov, count, remote_iov, count, 0UL);
+
+    if (r == -1 && errno == ENOSYS)
+        disable_process_vm();
 
     return r;
 }
 
 size_t DFInstanceLinux::read_raw_ptrace(const VPTR addr, const size_t bytes, void *buffer) {
-    int bytes_read = 0;
+    ssize_t bytes_read = -1;
 
-    // try to attach, will be ignored if we're already attached
+    // try to attach, will be ignored if we're already attached. the memory
+    // file stays open until the outermost detach, so reads during a load
+    // don't pay for a ptrace cycle each
     attach();
+    if (open_memory_session())
+        bytes_read = pread(m_mem_fd, buffer, bytes, static_cast<off_t>(reinterpret_cast<quintptr>(addr)));
+    detach();
 
-    // open the memory virtual file for this proc (can only read once
-    // attached and child is stopped
-    if (!m_memory_file.isOpen() && !m_memory_file.open(QIODevice::ReadOnly)) {
-        LOGE << "Unable to open" << m_memory_file.fileName();
-        detach();
-        return bytes_read;
-    }
+    if (bytes_read < 0)
+        bytes_read = 0;
+    if ((size_t)bytes_read < bytes)
+        memset(static_cast<char *>(buffer) + bytes_read, 0, bytes - bytes_read);
+    return bytes_read;
+}
 
-    m_memory_file.seek(reinterpret_cast<qint64>(addr));
-    bytes_read = m_memory_file.read(static_cast<char *>(buffer), bytes);
+size_t DFInstanceLinux::read_batch_ptrace(const QVector<ReadBatch::request> &reqs, int idx) {
+    size_t total = 0;
+    QVector<struct iovec> iov;
 
+    attach();
+    bool ok = open_memory_session();
+    while (idx < reqs.count()) {
+        // requests for adjoining remote memory are read with a single preadv
+        VPTR start = reqs.at(idx).addr;
+        VPTR next = start;
+        int end = idx;
+        iov.resize(0);
+        while (end < reqs.count() && iov.count() < IOV_MAX && reqs.at(end).addr == next) {
+            const ReadBatch::request &r = reqs.at(end);
+            struct iovec v = {r.buf, r.bytes};
+            iov.append(v);
+            next += r.bytes;
+            end++;
+        }
+
+        ssize_t bytes_read = -1;
+        if (ok)
+            bytes_read = preadv(m_mem_fd, iov.constData(), iov.count(), static_cast<off_t>(reinterpret_cast<quintptr>(start)));
+        size_t done = bytes_read < 0 ? 0 : bytes_read;
+        for (int i = idx; i < end; ++i) {
+            const ReadBatch::request &r = reqs.at(i);
+            size_t got = qMin(done, r.bytes);
+            if (got < r.bytes)
+                memset(static_cast<char *>(r.buf) + got, 0, r.bytes - got);
+            done -= got;
+            total += got;
+        }
+        idx = end;
+    }
     detach();
-    return bytes_read;
+
+    return total;
 }
 
-size_t DFInstanceLinux::read_raw(const VPTR addr, const size_t bytes, void *buffer) {
+size_t DFInstanceLinux::read_process_memory(const VPTR addr, const size_t bytes, void *buffer) {
+    if (m_pvm_unsupported)
+        return read_raw_ptrace(addr, bytes, buffer);
+
     ssize_t bytes_read = process_vm(SYS_process_vm_readv, addr, bytes, buffer);
     if (bytes_read < 0) {
         memset(buffer, 0, bytes);
 
-        if (errno != ENOSYS) {
+        if (!m_pvm_unsupported) {
             LOGE << "READ_RAW:" << QString(strerror(errno)) << "READING" << bytes << "BYTES FROM" << hexify(addr) << "TO" << buffer;
         }
         return read_raw_ptrace(addr, bytes, buffer);
@@ -162,6 +239,113 @@ size_t DFInstanceLinux::read_raw(const VPTR addr, const size_t bytes, void *buff
     return bytes_read;
 }
 
+size_t DFInstanceLinux::read_concurrent(VPTR addr, size_t bytes, void *buf) {
+    // process_vm_readv needs no ptrace stop, so worker threads can share it
+    struct iovec local_iov = {buf, bytes};
+    struct iovec remote_iov = {reinterpret_cast<void *>(addr), bytes};
+    ssize_t bytes_read = syscall(SYS_process_vm_readv, m_pid, &local_iov, 1UL, &remote_iov, 1UL, 0UL);
+    if (bytes_read < 0)
+        bytes_read = 0;
+    if ((size_t)bytes_read < bytes)
+        memset((char *)buf + bytes_read, 0, bytes - bytes_read);
+    return bytes_read;
+}
+
+size_t DFInstanceLinux::read_batch(const ReadBatch &batch) {
+    const QVector<ReadBatch::request> &reqs = batch.requests();
+    QVector<struct iovec> local_iov;
+    QVector<struct iovec> remote_iov;
+    size_t total = 0;
+    int idx = 0;
+
+    // snapshot recordings are served page by page by read_raw
+    if (recording())
+        return DFInstance::read_batch(batch);
+    if (m_pvm_unsupported)
+        return read_batch_ptrace(reqs, 0);
+
+    while (idx < reqs.count()) {
+        // send as many requests as the kernel accepts in a single call
+        int count = qMin(reqs.count() - idx, IOV_MAX);
+        local_iov.resize(count);
+        remote_iov.resize(count);
+        for (int i = 0; i < count; ++i) {
+            const ReadBatch::request &r = reqs.at(idx + i);
+            local_iov[i].iov_base = r.buf;
+            local_iov[i].iov_len = r.bytes;
+            remote_iov[i].iov_base = reinterpret_cast<void *>(r.addr);
+            remote_iov[i].iov_len = r.bytes;
+        }
+
+        ssize_t bytes_read = process_vm_batch(local_iov.constData(), remote_iov.constData(), count);
+        if (bytes_read < 0) {
+            if (m_pvm_unsupported) {
+                // no process_vm support at all, read the rest from the memory file
+                total += read_batch_ptrace(reqs, idx);
+                break;
+            }
+            bytes_read = 0;
+        }
+
+        // the kernel stops at the first remote region it can't read, so
+        // everything before that has been filled in completely
+        size_t done = static_cast<size_t>(bytes_read);
+        int i = 0;
+        while (i < count && reqs.at(idx + i).bytes <= done) {
+            done -= reqs.at(idx + i).bytes;
+            total += reqs.at(idx + i).bytes;
+            i++;
+        }
+        idx += i;
+
+        // retry the failing request individually (rejects unmapped addresses,
+        // logs and zero fills), then continue batching with the ones after it
+        if (i < count) {
+            const ReadBatch::request &r = reqs.at(idx);
+            total += read_raw(r.addr, r.bytes, r.buf);
+            idx++;
+        }
+    }
+
+    TRACE << "Read" << total << "bytes in a batch of" << reqs.count() << "requests";
+    return total;
+}
+
+bool DFInstanceLinux::load_memory_regions(QMap<quintptr, quintptr> &regions) {
+    if (!m_pid)
+        return false;
+
+    QFile maps(QString("/proc/%1/maps").arg(m_pid));
+    if (!maps.open(QIODevice::ReadOnly)) {
+        LOGW << "Unable to open" << maps.fileName();
+        return false;
+    }
+
+    // each line looks like: 08048000-0804c000 r-xp 00000000 08:01 1234 /path/to/file
+    quintptr last_start = 0;
+    quintptr last_end = 0;
+    foreach(const QByteArray &line, maps.readAll().split('\n')) {
+        int dash = line.indexOf('-');
+        int space = line.indexOf(' ', dash);
+        if (dash < 0 || space < 0 || space + 1 >= line.size() || line.at(space + 1) != 'r')
+            continue;
+        bool start_ok, end_ok;
+        quintptr start = line.left(dash).toULongLong(&start_ok, 16);
+        quintptr end = line.mid(dash + 1, space - dash - 1).toULongLong(&end_ok, 16);
+        if (!start_ok || !end_ok)
+            continue;
+        // merge adjoining mappings so reads spanning them are still valid
+        if (!regions.isEmpty() && start == last_end) {
+            regions[last_start] = end;
+        } else {
+            regions.insert(start, end);
+            last_start = start;
+        }
+        last_end = end;
+    }
+    return true;
+}
+
 size_t DFInstanceLinux::write_raw_ptrace(const VPTR addr, const size_t bytes,
                                         const void *buffer) {
     /* Since most kernels won't let us write to /proc/<pid>/mem, we have to poke
@@ -199,7 +383,7 @@ size_t DFInstanceLinux::write_raw_ptrace(const VPTR addr, const size_t bytes,
     // write any last stragglers
     if (bytes % stepsize) {
         unsigned long buf;
-        if (read_raw(addr + offset, stepsize, &buf) == stepsize) {
+        if (read_process_memory(addr + offset, stepsize, &buf) == stepsize) {
             memcpy(&buf, static_cast<const char *>(buffer) + offset, bytes % stepsize);
             if (ptrace(PTRACE_POKEDATA, m_pid, addr + offset, buf)) {
                 LOGE << "WRITE_RAW_PTRACE:" << QString(strerror(errno))
@@ -215,11 +399,14 @@ size_t DFInstanceLinux::write_raw_ptrace(const VPTR addr, const size_t bytes,
     return bytes_written;
 }
 
-size_t DFInstanceLinux::write_raw(const VPTR addr, const size_t bytes, const void *buffer) {
+size_t DFInstanceLinux::write_process_memory(const VPTR addr, const size_t bytes, const void *buffer) {
+    if (m_pvm_unsupported)
+        return write_raw_ptrace(addr, bytes, buffer);
+
     // const_cast is safe because process_vm passes the params as is
     ssize_t bytes_written = process_vm(SYS_process_vm_writev, addr, bytes, const_cast<void *>(buffer));
     if (bytes_written == -1) {
-        if (errno == ENOSYS) {
+        if (m_pvm_unsupported) {
             return write_raw_ptrace(addr, bytes, buffer);
         } else {
             LOGE << "WRITE_RAW:" << QString(strerror(errno)) << "WRITING" << bytes << "BYTES FROM" << buffer << "TO" << hexify(addr);
@@ -262,7 +449,6 @@ void DFInstanceLinux::find_running_copy() {
     TRACE << "attempting to find running copy of DF by executable name";
 
     if(set_pid()){
-        m_memory_file.setFileName(QString("/proc/%1/mem").arg(m_pid));
         TRACE << "USING PID:" << m_pid;
     }else{
         return;
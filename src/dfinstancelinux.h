@@ -33,11 +33,15 @@ public:
     void find_running_copy();
 
     size_t read_raw_ptrace(const VPTR addr, const size_t bytes, void *buffer);
-    size_t read_raw(const VPTR addr, const size_t bytes, void *buffer);
+    size_t read_process_memory(const VPTR addr, const size_t bytes, void *buffer);
+    size_t read_batch(const ReadBatch &batch);
+    bool concurrent_reads() {return !m_pvm_unsupported;}
+    bool reads_stop_process() {return m_pvm_unsupported;}
+    size_t read_concurrent(VPTR addr, size_t bytes, void *buf);
 
     // Writing
     size_t write_raw_ptrace(const VPTR addr, const size_t bytes, const void *buffer);
-    size_t write_raw(const VPTR addr, const size_t bytes, const void *buffer);
+    size_t write_process_memory(const VPTR addr, const size_t bytes, const void *buffer);
 
     bool attach();
     bool detach();
@@ -46,16 +50,21 @@ protected:
     bool set_pid();
     virtual bool mmap(size_t size);
     virtual bool mremap(size_t new_size);
+    bool load_memory_regions(QMap<quintptr, quintptr> &regions);
 
 private:
     int wait_for_stopped();
     ssize_t process_vm(long number, const VPTR addr, const size_t bytes, void *buffer);
+    ssize_t process_vm_batch(const struct iovec *local_iov, const struct iovec *remote_iov, unsigned long count);
+    void disable_process_vm();
+    bool open_memory_session();
+    size_t read_batch_ptrace(const QVector<ReadBatch::request> &reqs, int idx);
     long remote_syscall(int syscall_id,
                           long arg0 = 0, long arg1 = 0, long arg2 = 0,
                           long arg3 = 0, long arg4 = 0, long arg5 = 0);
 
-    QFile m_memory_file;
-    bool m_warned_pvm;
+    int m_mem_fd;
+    bool m_pvm_unsupported;
 };
 
 #endif // DFINSTANCE_H
@@ -1,4 +1,5 @@
 #include "dfinstancenix.h"
+#include "cp437codec.h"
 #include "truncatingfilelogger.h"
 #include <QCryptographicHash>
 #include <QFile>
@@ -10,6 +11,19 @@ struct STLStringHeader {
     int refcnt;
 };
 
+// anything longer is assumed to be garbage rather than a string
+static const size_t max_string_length = 8192;
+
+// sanity check the header in front of a string's characters, returning how many to read
+static size_t string_length(const STLStringHeader &header, VPTR addr) {
+    if (header.length > header.capacity || header.length > max_string_length) {
+        LOGW << "string at" << hexify(addr) << "is length" << header.length
+             << "with cap" << header.capacity << ", ignoring";
+        return 0;
+    }
+    return header.length;
+}
+
 DFInstanceNix::DFInstanceNix(QObject *parent)
     : DFInstance(parent)
     , m_pid(0)
@@ -38,10 +52,67 @@ QString DFInstanceNix::calculate_checksum() {
 }
 
 QString DFInstanceNix::read_string(VPTR addr) {
-    char buf[1024];
-    read_raw(read_addr(addr), sizeof(buf), (void *)buf);
+    VPTR str = read_addr(addr);
+    if (!is_valid_address(str))
+        return "";
+
+    // the length lives in the header just before the characters
+    STLStringHeader header;
+    if (read_raw(str - sizeof(header), sizeof(header), &header) != sizeof(header))
+        return "";
+    size_t len = string_length(header, str);
+    if (len == 0)
+        return "";
+
+    QByteArray buf(static_cast<int>(len), Qt::Uninitialized);
+    len = read_raw(str, len, buf.data());
+    return CP437Codec::decode(buf.constData(), static_cast<int>(len));
+}
 
-    return QTextCodec::codecForName("IBM437")->toUnicode(buf);
+QStringList DFInstanceNix::read_strings(const QVector<VPTR> &addrs) {
+    int count = addrs.count();
+
+    // pointers to the characters
+    QVector<VPTR> ptrs(count);
+    ReadBatch batch;
+    for (int i = 0; i < count; ++i)
+        batch.add(addrs.at(i), ptrs[i]);
+    read_batch(batch);
+
+    // the headers in front of them
+    QVector<STLStringHeader> headers(count);
+    batch.clear();
+    for (int i = 0; i < count; ++i) {
+        if (is_valid_address(ptrs.at(i)))
+            batch.add(ptrs.at(i) - sizeof(STLStringHeader), headers[i]);
+    }
+    read_batch(batch);
+
+    // and finally the characters themselves, packed into a single buffer
+    QVector<size_t> lengths(count);
+    size_t total = 0;
+    for (int i = 0; i < count; ++i) {
+        lengths[i] = string_length(headers.at(i), ptrs.at(i));
+        total += lengths.at(i);
+    }
+    QByteArray data(static_cast<int>(total), Qt::Uninitialized);
+    batch.clear();
+    size_t offset = 0;
+    for (int i = 0; i < count; ++i) {
+        if (lengths.at(i))
+            batch.add_raw(ptrs.at(i), lengths.at(i), data.data() + offset);
+        offset += lengths.at(i);
+    }
+    read_batch(batch);
+
+    QStringList result;
+    result.reserve(count);
+    offset = 0;
+    for (int i = 0; i < count; ++i) {
+        result.append(CP437Codec::decode(data.constData() + offset, static_cast<int>(lengths.at(i))));
+        offset += lengths.at(i);
+    }
+    return result;
 }
 
 bool DFInstanceNix::df_running(){
@@ -11,6 +11,7 @@ public:
     DFInstanceNix(QObject *parent);
 
     QString read_string(const VPTR addr);
+    QStringList read_strings(const QVector<VPTR> &addrs);
     size_t write_string(const VPTR addr, const QString &str);
 
     bool df_running();
@@ -35,8 +35,8 @@ public:
     virtual ~DFInstanceOSX();
     void find_running_copy();
 
-    size_t read_raw(VPTR addr, size_t bytes, void *buffer);
-    size_t write_raw(VPTR addr, size_t bytes, const void *buffer);
+    size_t read_process_memory(VPTR addr, size_t bytes, void *buffer);
+    size_t write_process_memory(VPTR addr, size_t bytes, const void *buffer);
 
     bool attach();
     bool detach();
@@ -113,7 +113,7 @@ bool DFInstanceOSX::detach() {
     return true;
 }
 
-size_t DFInstanceOSX::read_raw(VPTR addr, size_t bytes, void *buffer) {
+size_t DFInstanceOSX::read_process_memory(VPTR addr, size_t bytes, void *buffer) {
     vm_size_t bytes_read = 0;
     memset(buffer, 0, bytes);
 
@@ -124,7 +124,7 @@ size_t DFInstanceOSX::read_raw(VPTR addr, size_t bytes, void *buffer) {
     return bytes_read;
 }
 
-size_t DFInstanceOSX::write_raw(VPTR addr, size_t bytes, const void *buffer) {
+size_t DFInstanceOSX::write_process_memory(VPTR addr, size_t bytes, const void *buffer) {
     attach();
     kern_return_t result = vm_write(m_task, (vm_address_t)addr, (pointer_t)buffer, bytes);
     detach();
@@ -0,0 +1,120 @@
+/*
+Dwarf Therapist
+Copyright (c) 2009 Trey Stout (chmod)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "dfinstancesnapshot.h"
+#include "truncatingfilelogger.h"
+#include "utils.h"
+
+#include <QDataStream>
+#include <QFile>
+
+DFInstanceSnapshot::DFInstanceSnapshot(const QString &path, QObject *parent)
+    : DFInstancePlatform(parent)
+    , m_path(path)
+{
+}
+
+DFInstanceSnapshot::~DFInstanceSnapshot() {
+    m_attach_count = 0;
+}
+
+void DFInstanceSnapshot::find_running_copy() {
+    m_status = DFS_DISCONNECTED;
+    m_runs.clear();
+
+    QFile file(m_path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        LOGE << "Unable to open snapshot" << m_path;
+        return;
+    }
+    QByteArray data = qUncompress(file.readAll());
+    QDataStream in(data);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (magic != snapshot_magic || version != snapshot_version) {
+        LOGE << "Not a snapshot, or an unsupported version:" << m_path;
+        return;
+    }
+
+    QString checksum;
+    quint64 base_addr;
+    QString df_dir;
+    quint32 count;
+    in >> checksum >> base_addr >> df_dir >> count;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        quint64 start;
+        QByteArray bytes;
+        in >> start >> bytes;
+        m_runs.insert(start, bytes);
+    }
+    if (in.status() != QDataStream::Ok) {
+        LOGE << "Snapshot" << m_path << "is truncated";
+        m_runs.clear();
+        return;
+    }
+
+    size_t total = 0;
+    foreach(const QByteArray &run, m_runs) {
+        total += run.size();
+    }
+    LOGI << "Replaying snapshot" << m_path << "with" << m_runs.count() << "regions," << total << "bytes";
+
+    m_df_checksum = checksum;
+    m_base_addr = reinterpret_cast<VPTR>(base_addr);
+    m_df_dir = QDir(df_dir);
+    m_status = DFS_CONNECTED;
+    set_memory_layout(checksum);
+}
+
+size_t DFInstanceSnapshot::read_process_memory(VPTR addr, size_t bytes, void *buffer) {
+    memset(buffer, 0, bytes);
+    quintptr start = reinterpret_cast<quintptr>(addr);
+    const QMap<quintptr, QByteArray> &runs = m_runs;
+    QMap<quintptr, QByteArray>::const_iterator it = runs.upperBound(start);
+    if (it == runs.constBegin())
+        return 0;
+    --it;
+
+    size_t offset = start - it.key();
+    size_t run_size = it.value().size();
+    if (offset >= run_size)
+        return 0;
+    size_t len = qMin(bytes, run_size - offset);
+    memcpy(buffer, it.value().constData() + offset, len);
+    return len;
+}
+
+size_t DFInstanceSnapshot::write_process_memory(VPTR addr, size_t bytes, const void *buffer) {
+    Q_UNUSED(buffer);
+    LOGW << "ignoring write of" << bytes << "bytes to" << hexify(addr) << "while replaying a snapshot";
+    return 0;
+}
+
+bool DFInstanceSnapshot::load_memory_regions(QMap<quintptr, quintptr> &regions) {
+    for (QMap<quintptr, QByteArray>::const_iterator it = m_runs.constBegin(); it != m_runs.constEnd(); ++it) {
+        regions.insert(it.key(), it.key() + it.value().size());
+    }
+    return true;
+}
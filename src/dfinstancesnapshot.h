@@ -0,0 +1,71 @@
+/*
+Dwarf Therapist
+Copyright (c) 2009 Trey Stout (chmod)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#ifndef DFINSTANCE_SNAPSHOT_H
+#define DFINSTANCE_SNAPSHOT_H
+
+#include <QtGlobal>
+
+#ifdef Q_OS_WIN
+#include "dfinstancewindows.h"
+typedef DFInstanceWindows DFInstancePlatform;
+#elif defined(Q_OS_MAC)
+#include "dfinstanceosx.h"
+typedef DFInstanceOSX DFInstancePlatform;
+#else
+#include "dfinstancelinux.h"
+typedef DFInstanceLinux DFInstancePlatform;
+#endif
+
+/*! replays memory recorded from a live game (see DFInstance::start_recording)
+    without a running DF process. the platform's string format is inherited, so a
+    snapshot can only be replayed on the OS it was recorded on */
+class DFInstanceSnapshot : public DFInstancePlatform {
+    Q_OBJECT
+public:
+    DFInstanceSnapshot(const QString &path, QObject *parent=0);
+    virtual ~DFInstanceSnapshot();
+
+    void find_running_copy();
+    bool df_running() {return !m_runs.isEmpty();}
+
+    size_t read_batch(const ReadBatch &batch) {return DFInstance::read_batch(batch);}
+    bool concurrent_reads() {return true;}
+    size_t read_concurrent(VPTR addr, size_t bytes, void *buf) {return read_process_memory(addr, bytes, buf);}
+
+    bool attach() {m_attach_count++; return true;}
+    bool detach() {m_attach_count--; return true;}
+
+protected:
+    size_t read_process_memory(VPTR addr, size_t bytes, void *buffer);
+    size_t write_process_memory(VPTR addr, size_t bytes, const void *buffer);
+    bool load_memory_regions(QMap<quintptr, quintptr> &regions);
+    bool set_pid() {return true;}
+    bool mmap(size_t) {return false;}
+    bool mremap(size_t) {return false;}
+
+private:
+    QString m_path;
+    QMap<quintptr, QByteArray> m_runs; // start address -> recorded bytes
+};
+
+#endif // DFINSTANCE_SNAPSHOT_H
@@ -32,6 +32,7 @@ THE SOFTWARE.
 
 #include "dfinstance.h"
 #include "dfinstancewindows.h"
+#include "cp437codec.h"
 #include "defines.h"
 #include "truncatingfilelogger.h"
 #include "dwarf.h"
@@ -101,7 +102,7 @@ QString DFInstanceWindows::read_string(VPTR addr) {
     }
 
     read_raw(buffer_addr, len, buf);
-    return QTextCodec::codecForName("IBM437")->toUnicode(buf, len);
+    return CP437Codec::decode(reinterpret_cast<const char *>(buf), len);
 }
 
 size_t DFInstanceWindows::write_string(VPTR addr, const QString &str) {
@@ -141,7 +142,7 @@ bool DFInstanceWindows::mremap(size_t new_size) {
     return m_alloc_start;
 }
 
-size_t DFInstanceWindows::read_raw(VPTR addr, size_t bytes, void *buffer) {
+size_t DFInstanceWindows::read_process_memory(VPTR addr, size_t bytes, void *buffer) {
     ZeroMemory(buffer, bytes);
     size_t bytes_read = 0;
     if (!ReadProcessMemory(m_proc, reinterpret_cast<LPCVOID>(addr), buffer, bytes, &bytes_read))
@@ -149,7 +150,15 @@ size_t DFInstanceWindows::read_raw(VPTR addr, size_t bytes, void *buffer) {
     return bytes_read;
 }
 
-size_t DFInstanceWindows::write_raw(VPTR addr, size_t bytes, const void *buffer) {
+size_t DFInstanceWindows::read_concurrent(VPTR addr, size_t bytes, void *buf) {
+    // ReadProcessMemory is thread safe, only the error reporting isn't
+    ZeroMemory(buf, bytes);
+    size_t bytes_read = 0;
+    ReadProcessMemory(m_proc, reinterpret_cast<LPCVOID>(addr), buf, bytes, &bytes_read);
+    return bytes_read;
+}
+
+size_t DFInstanceWindows::write_process_memory(VPTR addr, size_t bytes, const void *buffer) {
     size_t bytes_written = 0;
     if (!WriteProcessMemory(m_proc, reinterpret_cast<LPVOID>(addr), buffer, bytes, &bytes_written))
         handle_error("WriteProcessMemory failed:");
@@ -39,11 +39,13 @@ public:
     void find_running_copy();
     bool df_running();
 
-    size_t read_raw(VPTR addr, size_t bytes, void *buffer);
+    size_t read_process_memory(VPTR addr, size_t bytes, void *buffer);
+    bool concurrent_reads() {return true;}
+    size_t read_concurrent(VPTR addr, size_t bytes, void *buf);
     QString read_string(VPTR addr);
 
     // Writing
-    size_t write_raw(VPTR addr, size_t bytes, const void *buffer);
+    size_t write_process_memory(VPTR addr, size_t bytes, const void *buffer);
     size_t write_string(VPTR addr, QString str);
 
     // windows doesn't really have a concept of
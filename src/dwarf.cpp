@@ -46,6 +46,7 @@ THE SOFTWARE.
 #include "material.h"
 #include "caste.h"
 #include "roleaspect.h"
+#include "rolescriptengine.h"
 
 #include "squad.h"
 #include "uniform.h"
@@ -64,13 +65,25 @@ THE SOFTWARE.
 #include <QTreeWidgetItem>
 #include <QVBoxLayout>
 #include <QVector>
-#ifdef QT_QML_LIB
-# include <QJSEngine>
-#else
-# include <QScriptEngine>
-# define QJSEngine QScriptEngine
-# define QJSValue QScriptValue
-#endif
+
+//layout of a unit_skill entry in DF's memory
+struct raw_skill {
+    qint16 id;
+    qint16 unk_02;
+    qint16 rating;
+    qint16 unk_06;
+    qint32 xp;
+    qint32 unused_counter;
+    qint32 rust;
+};
+
+template<typename T>
+T Dwarf::snapshot_field(const QByteArray &data, VPTR base, VPTRDIFF offset){
+    T val;
+    if(!snapshot_raw(data, base, offset, sizeof(T), &val))
+        val = T();
+    return val;
+}
 
 Dwarf::Dwarf(DFInstance *df, VPTR addr, QObject *parent)
     : QObject(parent)
@@ -211,26 +224,22 @@ void Dwarf::read_data() {
     // make sure our reference is up to date to the active memory layout
     m_mem = m_df->memory_layout();
     TRACE << "Starting refresh of unit data at" << hexify(m_address);
-
-    int civ_id = m_df->read_int(m_address +m_mem->dwarf_offset("civ"));
-    TRACE << "  CIV:" << civ_id;
+    read_snapshot();
 
     //read the core information we need to validate if we should continue loading this unit
-    read_id();
+    int civ_id = read_core_fields();
+    TRACE << "  CIV:" << civ_id;
     read_flags();
     read_race(); //also sets m_is_animal
     read_first_name();
-    read_last_name(m_address + m_mem->dwarf_offset("first_name"));
+    read_last_name(m_address + m_mem->dwarf_offset(MemoryLayout::DWARF_FIRST_NAME));
     read_nick_name();
     build_names(); //build names now for logging
     read_states();  //read states before job and validation
     read_caste(); //read before age
-    read_turn_count(); //load time/date stuff for births/migrations - read before age
-    set_age_and_migration(m_address + m_mem->dwarf_offset("birth_year"), m_address + m_mem->dwarf_offset("birth_time")); //set age before profession, after caste
+    calc_age_and_migration(); //set age before profession, after caste
 
-    m_raw_prof_id = m_df->read_byte(m_address + m_mem->dwarf_offset("profession"));
     m_raw_profession = GameDataReader::ptr()->get_profession(m_raw_prof_id);
-    m_histfig_id = m_df->read_int(m_address + m_mem->dwarf_offset("hist_id"));
 
     bool validated = true;
     //attempt to do some initial filtering on the civilization
@@ -242,7 +251,7 @@ void Dwarf::read_data() {
             set_validation("IGNORING child/baby",&validated,false);
         }
         //filter out any non-mercenary visitors if necessary
-        m_is_citizen = m_df->fortress()->hist_figures().contains(m_histfig_id);
+        m_is_citizen = m_df->fortress()->has_hist_figure(m_histfig_id);
         TRACE << "HIST_FIG_ID:" << m_histfig_id;
         if(DT->hide_non_citizens() && !m_is_citizen && !m_raw_profession->is_military()){
             set_validation("IGNORING visitor/guest",&validated,false);
@@ -294,6 +303,7 @@ void Dwarf::read_data() {
         if(m_is_animal || m_nice_name == "")
             build_names(); //calculate names again as we need to check tameness for animals
     }
+    release_snapshot();
 
     if(m_is_valid){
         LOGI << QString("FOUND %1 (%2) name:%3 id:%4 histfig_id:%5")
@@ -304,6 +314,7 @@ void Dwarf::read_data() {
 
 void Dwarf::refresh_minimal_data(){
     if(m_is_valid){
+        read_snapshot();
         read_flags(); //butcher/caged
 
         read_nick_name();
@@ -312,9 +323,53 @@ void Dwarf::refresh_minimal_data(){
         read_profession();
 
         build_names();
+        release_snapshot();
     }
 }
 
+void Dwarf::read_snapshot(){
+    //copy the whole unit in one read, so every field is decoded from the same point in time
+    m_unit_data.clear();
+    m_soul_data.clear();
+    if(!DT->user_settings()->value("options/read_unit_snapshots", true).toBool())
+        return;
+    uint size = m_mem->unit_size();
+    if(size > 0 && !m_df->take_prefetched_unit(m_address, m_unit_data)){
+        size_t bytes_read = m_df->read_raw(m_address, size, m_unit_data);
+        m_unit_data.resize(bytes_read);
+    }
+}
+
+void Dwarf::read_soul_snapshot(){
+    m_soul_data.clear();
+    uint size = m_mem->soul_size();
+    if(m_first_soul && size > 0 && !m_unit_data.isEmpty() &&
+            !m_df->take_prefetched_soul(m_address, m_first_soul, m_soul_data)){
+        size_t bytes_read = m_df->read_raw(m_first_soul, size, m_soul_data);
+        m_soul_data.resize(bytes_read);
+    }
+}
+
+void Dwarf::release_snapshot(){
+    m_unit_data.clear();
+    m_soul_data.clear();
+}
+
+bool Dwarf::snapshot_raw(const QByteArray &data, VPTR base, VPTRDIFF offset, size_t bytes, void *buf){
+    if(offset >= 0 && offset + bytes <= (size_t)data.size()){
+        memcpy(buf, data.constData() + offset, bytes);
+        return true;
+    }
+    //not covered by the snapshot, fall back to reading the field from DF
+    return m_df->read_raw(base + offset, bytes, buf) == bytes;
+}
+
+QVector<VPTR> Dwarf::snapshot_vector(const QByteArray &data, VPTR base, VPTRDIFF offset){
+    VPTR start = snapshot_field<VPTR>(data, base, offset);
+    VPTR end = snapshot_field<VPTR>(data, base, offset + sizeof(VPTR));
+    return m_df->enum_vec<VPTR>(start, end, base + offset);
+}
+
 bool Dwarf::validate(){
     if (m_mem->is_complete()) {
 
@@ -336,7 +391,7 @@ bool Dwarf::validate(){
         if(m_is_animal && (get_flag_value(FLAG_TAME) || get_flag_value(FLAG_CAGED))){ //tame or caged animals
             //exclude cursed animals, this may be unnecessary with the civ check
             //the full curse information hasn't been loaded yet, so just read the curse name
-            QString curse_name = m_df->read_string(m_address + m_mem->dwarf_offset("curse"));
+            QString curse_name = m_df->read_string(m_address + m_mem->dwarf_offset(MemoryLayout::DWARF_CURSE));
             if(!curse_name.isEmpty()){
                 set_validation("appears to be cursed or undead",&m_is_valid);
                 return false;
@@ -374,9 +429,15 @@ void Dwarf::set_validation(QString reason, bool *valid_var, bool valid){
 }
 
 void Dwarf::set_age_and_migration(VPTR birth_year_offset, VPTR birth_time_offset){
-    m_birth_year = m_df->read_int(birth_year_offset);
+    DFInstance::ReadBatch batch;
+    batch.add(birth_year_offset, m_birth_year);
+    batch.add(birth_time_offset, m_birth_time);
+    m_df->read_batch(batch);
+    calc_age_and_migration();
+}
+
+void Dwarf::calc_age_and_migration(){
     m_age = m_df->current_year() - m_birth_year;
-    m_birth_time = m_df->read_int(birth_time_offset);
     quint32 arrival_time = m_df->current_time() - m_turn_count;
     quint32 arrival_year = arrival_time / m_df->ticks_per_year;
     quint32 arrival_season = (arrival_time %  m_df->ticks_per_year) /  m_df->ticks_per_season;
@@ -428,13 +489,25 @@ QString Dwarf::get_migration_desc(){
   DATA POPULATION METHODS
 *******************************************************************************/
 
-void Dwarf::read_id() {
-    m_id = m_df->read_int(m_address + m_mem->dwarf_offset("id"));
+int Dwarf::read_core_fields() {
+    //scalar fields used for validation, age and migration
+    int civ_id = unit_field<qint32>(m_mem->dwarf_offset(MemoryLayout::DWARF_CIV));
+    m_id = unit_field<qint32>(m_mem->dwarf_offset(MemoryLayout::DWARF_ID));
+    m_race_id = unit_field<qint32>(m_mem->dwarf_offset(MemoryLayout::DWARF_RACE));
+    m_caste_id = unit_field<qint16>(m_mem->dwarf_offset(MemoryLayout::DWARF_CASTE));
+    m_turn_count = unit_field<quint32>(m_mem->dwarf_offset(MemoryLayout::DWARF_TURN_COUNT));
+    m_birth_year = unit_field<quint32>(m_mem->dwarf_offset(MemoryLayout::DWARF_BIRTH_YEAR));
+    m_birth_time = unit_field<quint32>(m_mem->dwarf_offset(MemoryLayout::DWARF_BIRTH_TIME));
+    m_raw_prof_id = unit_field<quint8>(m_mem->dwarf_offset(MemoryLayout::DWARF_PROFESSION));
+    m_histfig_id = unit_field<qint32>(m_mem->dwarf_offset(MemoryLayout::DWARF_HIST_ID));
+
     TRACE << "UNIT ID:" << m_id;
+    TRACE << "Turn Count:" << m_turn_count;
+    return civ_id;
 }
 
 void Dwarf::read_gender_orientation() {
-    auto sex = m_df->read_byte(m_address + m_mem->dwarf_offset("sex"));
+    auto sex = unit_field<quint8>(m_mem->dwarf_offset(MemoryLayout::DWARF_SEX));
     TRACE << "GENDER:" << sex;
     m_gender_info.gender = static_cast<GENDER_TYPE>(sex);
     m_gender_info.orientation = ORIENT_HETERO; //default
@@ -449,9 +522,9 @@ void Dwarf::read_gender_orientation() {
         icon_name.append("female");
     }
 
-    int orient_offset = m_mem->soul_detail("orientation");
+    int orient_offset = m_mem->soul_detail(MemoryLayout::SOUL_ORIENTATION);
     if(m_gender_info.gender != SEX_UNK && m_first_soul && orient_offset != -1){
-        auto orientation = m_df->read_word(m_first_soul + orient_offset);
+        auto orientation = soul_field<quint32>(orient_offset);
         m_gender_info.male_interest = orientation & (1 << 1);
         m_gender_info.male_commit = orientation & (1 << 2);
         m_gender_info.female_interest = orientation & (1 << 3);
@@ -493,10 +566,10 @@ QString Dwarf::get_gender_icon_suffix(bool male_flag, bool female_flag, bool che
 }
 
 void Dwarf::read_mood(){
-    m_mood_id = static_cast<MOOD_TYPE>(m_df->read_short(m_address + m_mem->dwarf_offset("mood")));
-    int temp_offset = m_mem->dwarf_offset("temp_mood");
+    m_mood_id = static_cast<MOOD_TYPE>(unit_field<qint16>(m_mem->dwarf_offset(MemoryLayout::DWARF_MOOD)));
+    int temp_offset = m_mem->dwarf_offset(MemoryLayout::DWARF_TEMP_MOOD);
     if(m_mood_id == MT_NONE && temp_offset != -1){
-        short temp_mood = m_df->read_short(m_address + temp_offset); //check temporary moods
+        short temp_mood = unit_field<qint16>(temp_offset); //check temporary moods
         if(temp_mood > -1)
             m_mood_id = static_cast<MOOD_TYPE>(10 + temp_mood); //appended to craft/stress moods enum
     }
@@ -510,7 +583,7 @@ void Dwarf::read_mood(){
     if(m_mood_id == MT_NONE || (int)m_mood_id > 4){
         if(get_flag_value(FLAG_HAD_MOOD)){
             m_had_mood = true;
-            m_artifact_name = m_df->get_translated_word(m_address + m_mem->dwarf_offset("artifact_name"));
+            m_artifact_name = m_df->get_translated_word(m_address + m_mem->dwarf_offset(MemoryLayout::DWARF_ARTIFACT_NAME));
         }
         //filter out any other temporary combat moods, and set stressed mood flag
         if(m_mood_id != MT_NONE && m_mood_id != MT_MARTIAL && m_mood_id != MT_ENRAGED){
@@ -529,9 +602,9 @@ void Dwarf::read_mood(){
 
 void Dwarf::read_body_size(){
     //actual size of the creature
-    int offset = m_mem->dwarf_offset("size_info");
+    int offset = m_mem->dwarf_offset(MemoryLayout::DWARF_SIZE_INFO);
     if(offset){
-        m_body_size = m_df->read_int(m_address + offset);
+        m_body_size = unit_field<qint32>(offset);
     }else{
         LOGW << "Missing size_info offset!";
         m_body_size = body_size(true);
@@ -554,15 +627,15 @@ int Dwarf::body_size(bool use_default){
 
 void Dwarf::read_animal_type(){
     if(m_is_animal){
-        qint32 animal_offset = m_mem->dwarf_offset("animal_type");
+        qint32 animal_offset = m_mem->dwarf_offset(MemoryLayout::DWARF_ANIMAL_TYPE);
         if(animal_offset>=0)
-            m_animal_type = static_cast<TRAINED_LEVEL>(m_df->read_int(m_address + animal_offset));
+            m_animal_type = static_cast<TRAINED_LEVEL>(unit_field<qint32>(animal_offset));
 
         //additionally if it's an animal set a flag if it's currently a pet
         //since butchering available pets simply by setting the flag breaks shit in game
-        qint32 owner_offset = m_mem->dwarf_offset("pet_owner_id");
+        qint32 owner_offset = m_mem->dwarf_offset(MemoryLayout::DWARF_PET_OWNER_ID);
         if(owner_offset >=0){
-            int pet_owner_id = m_df->read_int(m_address + owner_offset); //check for an owner
+            int pet_owner_id = unit_field<qint32>(owner_offset); //check for an owner
             m_is_pet = (pet_owner_id > 0);
         }else{
             m_is_pet = (!m_first_name.isEmpty() && !m_last_name.isEmpty()); //assume that a first and last name on an animal is a pet
@@ -573,10 +646,9 @@ void Dwarf::read_animal_type(){
 void Dwarf::read_states(){
     //set of misc. traits and a value (cave adapt, migrant, likes outdoors, etc..)
     m_states.clear();
-    uint states_offset = m_mem->dwarf_offset("states");
+    uint states_offset = m_mem->dwarf_offset(MemoryLayout::DWARF_STATES);
     if(states_offset) {
-        VPTR states_addr = m_address + states_offset;
-        QVector<VPTR> entries = m_df->enumerate_vector(states_addr);
+        QVector<VPTR> entries = unit_vector(states_offset);
         foreach(VPTR entry, entries) {
             m_states.insert(m_df->read_short(entry), m_df->read_int(entry+0x4));
         }
@@ -584,7 +656,7 @@ void Dwarf::read_states(){
 }
 
 void Dwarf::read_curse(){
-    QString curse_name = capitalizeEach(m_df->read_string(m_address + m_mem->dwarf_offset("curse")));
+    QString curse_name = capitalizeEach(m_df->read_string(m_address + m_mem->dwarf_offset(MemoryLayout::DWARF_CURSE)));
 
     if(!curse_name.isEmpty()){
         m_curse_type = eCurse::OTHER;
@@ -627,28 +699,26 @@ HistFigure* Dwarf::hist_figure(){
 }
 
 void Dwarf::read_caste() {
-    m_caste_id = m_df->read_short(m_address + m_mem->dwarf_offset("caste"));
     m_caste = m_race->get_caste_by_id(m_caste_id);
     TRACE << "CASTE:" << m_caste_id;
 }
 
 void Dwarf::read_flags(){
     m_unit_flags.clear();
-    auto flags1 = m_df->read_word(m_address + m_mem->dwarf_offset("flags1"));
+    auto flags1 = unit_field<quint32>(m_mem->dwarf_offset(MemoryLayout::DWARF_FLAGS1));
+    auto flags2 = unit_field<quint32>(m_mem->dwarf_offset(MemoryLayout::DWARF_FLAGS2));
+    auto flags3 = unit_field<quint32>(m_mem->dwarf_offset(MemoryLayout::DWARF_FLAGS3));
+    m_curse_flags = unit_field<quint32>(m_mem->dwarf_offset(MemoryLayout::DWARF_CURSE_ADD_FLAGS1));
     TRACE << "  FLAGS1:" << hexify(flags1);
-    auto flags2 = m_df->read_word(m_address + m_mem->dwarf_offset("flags2"));
     TRACE << "  FLAGS2:" << hexify(flags2);
-    auto flags3 = m_df->read_word(m_address + m_mem->dwarf_offset("flags3"));
     TRACE << "  FLAGS3:" << hexify(flags3);
     m_unit_flags << flags1 << flags2 << flags3;
     m_pending_flags = m_unit_flags;
 
-    m_curse_flags = m_df->read_word(m_address + m_mem->dwarf_offset("curse_add_flags1"));
     //    m_curse_flags2 = m_df->read_addr(m_address + m_mem->dwarf_offset("curse_add_flags2"));
 }
 
 void Dwarf::read_race() {
-    m_race_id = m_df->read_int(m_address + m_mem->dwarf_offset("race"));
     m_race = m_df->get_race(m_race_id);
     TRACE << "RACE ID:" << m_race_id;
     if(m_race){
@@ -657,7 +727,7 @@ void Dwarf::read_race() {
 }
 
 void Dwarf::read_first_name() {
-    m_first_name = m_df->read_string(m_address + m_mem->dwarf_offset("first_name"));
+    m_first_name = m_df->read_string(m_address + m_mem->dwarf_offset(MemoryLayout::DWARF_FIRST_NAME));
     if (m_first_name.size() > 1)
         m_first_name[0] = m_first_name[0].toUpper();
     TRACE << "FIRSTNAME:" << m_first_name;
@@ -676,7 +746,7 @@ void Dwarf::read_last_name(VPTR name_offset) {
 
 
 void Dwarf::read_nick_name() {
-    m_nick_name = m_df->read_string(m_address + m_mem->dwarf_offset("nick_name"));
+    m_nick_name = m_df->read_string(m_address + m_mem->dwarf_offset(MemoryLayout::DWARF_NICK_NAME));
     TRACE << "\tNICKNAME:" << m_nick_name;
     m_pending_nick_name = m_nick_name;
 }
@@ -726,7 +796,7 @@ void Dwarf::build_names() {
 
 void Dwarf::read_profession() {
     // first see if there is a custom prof set...
-    VPTR custom_addr = m_address + m_mem->dwarf_offset("custom_profession");
+    VPTR custom_addr = m_address + m_mem->dwarf_offset(MemoryLayout::DWARF_CUSTOM_PROFESSION);
     m_custom_prof_name = m_df->read_string(custom_addr);
     TRACE << "\tCUSTOM PROF:" << m_custom_prof_name;
 
@@ -782,7 +852,7 @@ void Dwarf::read_noble_position(){
 void Dwarf::read_preferences(){
     if(m_is_animal)
         return;
-    QVector<VPTR> preferences = m_df->enumerate_vector(m_first_soul + m_mem->soul_detail("preferences"));
+    QVector<VPTR> preferences = soul_vector(m_mem->soul_detail(MemoryLayout::SOUL_PREFERENCES));
     int pref_type;
     int pref_id;
     int item_sub_type;
@@ -972,7 +1042,7 @@ void Dwarf::read_preferences(){
 
 void Dwarf::read_syndromes(){
     m_syndromes.clear();
-    QVector<VPTR> active_unit_syns = m_df->enumerate_vector(m_address + m_mem->dwarf_offset("active_syndrome_vector"));
+    QVector<VPTR> active_unit_syns = unit_vector(m_mem->dwarf_offset(MemoryLayout::DWARF_ACTIVE_SYNDROME_VECTOR));
     //when showing syndromes, be sure to exclude 'vampcurse' and 'werecurse' if we're hiding cursed dwarves
     bool show_cursed = DT->user_settings()->value("options/highlight_cursed",false).toBool();
     bool is_curse = false;
@@ -1089,11 +1159,10 @@ QString Dwarf::get_syndrome_names(bool include_buffs, bool include_sick) {
 
 
 void Dwarf::read_labors() {
-    VPTR addr = m_address + m_mem->dwarf_offset("labors");
     // read a big array of labors in one read, then pick and choose
     // the values we care about
     QByteArray buf(94, 0);
-    m_df->read_raw(addr, 94, buf);
+    unit_raw(m_mem->dwarf_offset(MemoryLayout::DWARF_LABORS), buf.size(), buf.data());
 
     // get the list of identified labors from game_data.ini
     GameDataReader *gdr = GameDataReader::ptr();
@@ -1156,8 +1225,7 @@ void Dwarf::check_availability(){
 }
 
 void Dwarf::read_current_job(){
-    VPTR addr = m_address + m_mem->dwarf_offset("current_job");
-    VPTR current_job_addr = m_df->read_addr(addr);
+    VPTR current_job_addr = unit_field<VPTR>(m_mem->dwarf_offset(MemoryLayout::DWARF_CURRENT_JOB));
     m_current_sub_job_id.clear();
 
     TRACE << "Current job addr: " << hex << current_job_addr;
@@ -1217,9 +1285,9 @@ void Dwarf::read_current_job(){
         }
 
         int meeting = 0;
-        int offset = m_mem->dwarf_offset("meeting");
+        int offset = m_mem->dwarf_offset(MemoryLayout::DWARF_MEETING);
         if(offset != -1){
-            meeting = m_df->read_byte(m_address + offset);
+            meeting = unit_field<quint8>(offset);
         }
         if(meeting == 2){ //needs more work; !=2 for conduct meeting
             m_current_job_id = DwarfJob::JOB_MEETING;
@@ -1254,13 +1322,13 @@ void Dwarf::read_current_job(){
 }
 
 bool Dwarf::read_soul(){
-    VPTR soul_vector = m_address + m_mem->dwarf_offset("souls");
-    QVector<VPTR> souls = m_df->enumerate_vector(soul_vector);
+    QVector<VPTR> souls = unit_vector(m_mem->dwarf_offset(MemoryLayout::DWARF_SOULS));
     if (souls.size() != 1) {
         LOGI << nice_name() << "has" << souls.size() << "souls!";
         return false;
     }
     m_first_soul = souls.at(0);
+    read_soul_snapshot();
     return true;
 }
 
@@ -1402,9 +1470,9 @@ quint32 Dwarf::build_flag_mask(int bit){
 }
 
 void Dwarf::read_squad_info() {
-    m_squad_id = m_df->read_int(m_address + m_mem->dwarf_offset("squad_id"));
+    m_squad_id = unit_field<qint32>(m_mem->dwarf_offset(MemoryLayout::DWARF_SQUAD_ID));
     m_pending_squad_id = m_squad_id;
-    m_squad_position = m_df->read_int(m_address + m_mem->dwarf_offset("squad_position"));
+    m_squad_position = unit_field<qint32>(m_mem->dwarf_offset(MemoryLayout::DWARF_SQUAD_POSITION));
     m_pending_squad_position = m_squad_position;
     if(m_pending_squad_id >= 0 && !m_is_animal && is_adult()){
         Squad *s = m_df->get_squad(m_pending_squad_id);
@@ -1458,10 +1526,10 @@ void Dwarf::read_inventory(){
     int shoes_count = 0;
     bool has_pants = false;
 
-    QVector<VPTR> used_items = m_df->enumerate_vector(m_address + m_mem->dwarf_offset("used_items_vector"));
+    QVector<VPTR> used_items = unit_vector(m_mem->dwarf_offset(MemoryLayout::DWARF_USED_ITEMS_VECTOR));
     QHash<int,int> item_affection;
     foreach(VPTR item_used, used_items){
-        item_affection.insert(m_df->read_int(item_used),m_df->read_int(item_used+m_mem->dwarf_offset("affection_level")));
+        item_affection.insert(m_df->read_int(item_used),m_df->read_int(item_used+m_mem->dwarf_offset(MemoryLayout::DWARF_AFFECTION_LEVEL)));
     }
 
     short inv_type = -1;
@@ -1469,9 +1537,9 @@ void Dwarf::read_inventory(){
     QString category_name = "";
     int inv_count = 0;
     bool include_mat_name = DT->user_settings()->value("options/docks/equipoverview_include_mats",false).toBool();
-    foreach(VPTR inventory_item_addr, m_df->enumerate_vector(m_address + m_mem->dwarf_offset("inventory"))){
-        inv_type = m_df->read_short(inventory_item_addr + m_mem->dwarf_offset("inventory_item_mode"));
-        bp_id = m_df->read_short(inventory_item_addr + m_mem->dwarf_offset("inventory_item_bodypart"));
+    foreach(VPTR inventory_item_addr, unit_vector(m_mem->dwarf_offset(MemoryLayout::DWARF_INVENTORY))){
+        inv_type = m_df->read_short(inventory_item_addr + m_mem->dwarf_offset(MemoryLayout::DWARF_INVENTORY_ITEM_MODE));
+        bp_id = m_df->read_short(inventory_item_addr + m_mem->dwarf_offset(MemoryLayout::DWARF_INVENTORY_ITEM_BODYPART));
 
         if(inv_type == 1 || inv_type == 2 || inv_type == 4 || inv_type == 8 || inv_type == 10){
             if(bp_id >= 0)
@@ -1666,19 +1734,13 @@ float Dwarf::get_coverage_rating(ITEM_TYPE itype){
 }
 
 
-void Dwarf::read_turn_count() {
-    m_turn_count = m_df->read_int(m_address + m_mem->dwarf_offset("turn_count"));
-    TRACE << "Turn Count:" << m_turn_count;
-}
-
 void Dwarf::read_skills() {
-    VPTR addr = m_first_soul + m_mem->soul_detail("skills");
     m_total_xp = 0;
     m_skills.clear();
     m_sorted_skills.clear();
     m_moodable_skills.clear();
 
-    QVector<VPTR> entries = m_df->enumerate_vector(addr);
+    QVector<VPTR> entries = soul_vector(m_mem->soul_detail(MemoryLayout::SOUL_SKILLS));
     TRACE << "Reading skills for" << nice_name() << "found:" << entries.size();
     short skill_id = 0;
     short rating = 0;
@@ -1691,11 +1753,19 @@ void Dwarf::read_skills() {
 
     QMultiMap<int,Skill> skills_by_level;
 
-    foreach(VPTR entry, entries) {
-        skill_id = m_df->read_short(entry);
-        rating = m_df->read_short(entry + 0x04);
-        xp = m_df->read_int(entry + 0x08);
-        rust = m_df->read_int(entry + 0x10);
+    //fetch every skill entry with a single batch read
+    QVector<raw_skill> raw_skills(entries.size());
+    DFInstance::ReadBatch batch;
+    for(int idx = 0; idx < entries.size(); idx++){
+        batch.add(entries.at(idx), raw_skills[idx]);
+    }
+    m_df->read_batch(batch);
+
+    foreach(const raw_skill &entry, raw_skills) {
+        skill_id = entry.id;
+        rating = entry.rating;
+        xp = entry.xp;
+        rust = entry.rust;
 
         //find the caste's skill rate
         if(m_caste){
@@ -1728,17 +1798,17 @@ void Dwarf::read_skills() {
             m_moodable_skills.insert(-1,Skill());
         }
     }else{
-        int mood_skill = m_df->read_short(m_address +m_mem->dwarf_offset("mood_skill"));
+        int mood_skill = unit_field<qint16>(m_mem->dwarf_offset(MemoryLayout::DWARF_MOOD_SKILL));
         m_moodable_skills.insert(mood_skill, get_skill(mood_skill));
     }
 }
 
-void Dwarf::read_emotions(VPTR personality_base){
+void Dwarf::read_emotions(VPTRDIFF personality_offset){
     QString pronoun = (m_gender_info.gender == SEX_M ? tr("he") : tr("she"));
     //read list of circumstances and emotions, group and build desc
-    int offset = m_mem->soul_detail("emotions");
+    int offset = m_mem->soul_detail(MemoryLayout::SOUL_EMOTIONS);
     if(offset != -1){
-        QVector<VPTR> emotions_addrs = m_df->enumerate_vector(personality_base + offset);
+        QVector<VPTR> emotions_addrs = soul_vector(personality_offset + offset);
         //load emotions by date
         QMap<int,UnitEmotion*> all_emotions;
         foreach(VPTR addr, emotions_addrs){
@@ -1824,9 +1894,9 @@ void Dwarf::read_emotions(VPTR personality_base){
     }
 
     //read stress and convert to happiness level
-    offset = m_mem->soul_detail("stress_level");
+    offset = m_mem->soul_detail(MemoryLayout::SOUL_STRESS_LEVEL);
     if(offset != -1){
-        m_stress_level = m_df->read_int(personality_base+offset);
+        m_stress_level = soul_field<qint32>(personality_offset + offset);
     }else{
         m_stress_level = 0;
     }
@@ -1868,11 +1938,11 @@ void Dwarf::read_emotions(VPTR personality_base){
 
 void Dwarf::read_personality() {
     if(!m_is_animal){
-        VPTR personality_addr = m_first_soul + m_mem->soul_detail("personality");
+        VPTRDIFF personality_offset = m_mem->soul_detail(MemoryLayout::SOUL_PERSONALITY);
 
         //read personal beliefs before traits, as a dwarf will have a conflict with either personal beliefs or cultural beliefs
         m_beliefs.clear();
-        QVector<VPTR> beliefs_addrs = m_df->enumerate_vector(personality_addr + m_mem->soul_detail("beliefs"));
+        QVector<VPTR> beliefs_addrs = soul_vector(personality_offset + m_mem->soul_detail(MemoryLayout::SOUL_BELIEFS));
         foreach(VPTR addr, beliefs_addrs){
             int belief_id = m_df->read_int(addr);
             if(belief_id >= 0){
@@ -1882,12 +1952,13 @@ void Dwarf::read_personality() {
             }
         }
 
-        VPTR traits_addr = personality_addr + m_mem->soul_detail("traits");
         m_traits.clear();
         m_conflicting_beliefs.clear();
         int trait_count = GameDataReader::ptr()->get_total_trait_count();
+        QVector<qint16> trait_values(trait_count);
+        soul_raw(personality_offset + m_mem->soul_detail(MemoryLayout::SOUL_TRAITS), trait_count * sizeof(qint16), trait_values.data());
         for (int trait_id = 0; trait_id < trait_count; ++trait_id) {
-            short val = m_df->read_short(traits_addr + trait_id * 2);
+            short val = trait_values.at(trait_id);
             if(val < 0)
                 val = 0;
             if(val > 100)
@@ -1927,12 +1998,12 @@ void Dwarf::read_personality() {
             }
         }
 
-        QVector<VPTR> m_goals_addrs = m_df->enumerate_vector(personality_addr + m_mem->soul_detail("goals"));
+        QVector<VPTR> m_goals_addrs = soul_vector(personality_offset + m_mem->soul_detail(MemoryLayout::SOUL_GOALS));
         m_goals.clear();
         foreach(VPTR addr, m_goals_addrs){
             int goal_type = m_df->read_int(addr + 0x0004);
             if(goal_type >= 0){
-                short val = m_df->read_short(addr + m_mem->soul_detail("goal_realized")); //goal realized
+                short val = m_df->read_short(addr + m_mem->soul_detail(MemoryLayout::SOUL_GOAL_REALIZED)); //goal realized
                 //if we're not showing vampires, and this dwarf is a vampire, keep the goal hidden so they can't be identified from that
                 if(goal_type == 11 && m_curse_type == eCurse::VAMPIRE &&  DT->user_settings()->value("options/highlight_cursed", false).toBool()==false)
                     continue;
@@ -1944,7 +2015,7 @@ void Dwarf::read_personality() {
         }
 
         //read after traits
-        read_emotions(personality_addr);
+        read_emotions(personality_offset);
     }
 }
 
@@ -1979,26 +2050,28 @@ UnitBelief Dwarf::get_unit_belief(int belief_id){
 
 void Dwarf::read_attributes() {
     m_attributes.clear();
+    //each attribute is 7 ints (value, max, counters)
+    qint32 phys_attrs[6][7];
+    qint32 mental_attrs[13][7];
+    unit_raw(m_mem->dwarf_offset(MemoryLayout::DWARF_PHYSICAL_ATTRS), sizeof(phys_attrs), phys_attrs);
+    soul_raw(m_mem->soul_detail(MemoryLayout::SOUL_MENTAL_ATTRS), sizeof(mental_attrs), mental_attrs);
+
     //read the physical attributes
-    VPTR addr = m_address + m_mem->dwarf_offset("physical_attrs");
     for(int i=0; i<6; i++){
-        load_attribute(addr, static_cast<ATTRIBUTES_TYPE>(i));
+        load_attribute(phys_attrs[i][0], phys_attrs[i][1], static_cast<ATTRIBUTES_TYPE>(i));
     }
     //read the mental attributes, but append to our array (augment the key by the number of physical attribs)
     int phys_size = m_attributes.size();
-    addr = m_first_soul + m_mem->soul_detail("mental_attrs");
     for(int i=0; i<13; i++){
-        load_attribute(addr, static_cast<ATTRIBUTES_TYPE>(i+phys_size));
+        load_attribute(mental_attrs[i][0], mental_attrs[i][1], static_cast<ATTRIBUTES_TYPE>(i+phys_size));
     }
 }
 
-void Dwarf::load_attribute(VPTR &addr, ATTRIBUTES_TYPE id){
+void Dwarf::load_attribute(int value, int limit, ATTRIBUTES_TYPE id){
     int cti = 500;
     QPair<int,QString> desc; //index, description of descriptor
 
-    int value = (int)m_df->read_int(addr);
     int display_value = value;
-    int limit = (int)m_df->read_int(addr+0x4);
 
     //apply any permanent syndrome changes to the raw/base value
     int perm_add = 0;
@@ -2035,7 +2108,6 @@ void Dwarf::load_attribute(VPTR &addr, ATTRIBUTES_TYPE id){
         a.set_syn_names(m_attribute_syndromes.value(id));
 
     m_attributes.append(a);
-    addr+=0x1c;
 }
 
 Attribute Dwarf::get_attribute(ATTRIBUTES_TYPE id){
@@ -2258,7 +2330,7 @@ void Dwarf::clear_pending() {
 }
 
 void Dwarf::commit_pending(bool single) {
-    VPTR addr = m_address + m_mem->dwarf_offset("labors");
+    VPTR addr = m_address + m_mem->dwarf_offset(MemoryLayout::DWARF_LABORS);
 
     QByteArray buf(94, 0);
     m_df->read_raw(addr, 94, buf); // set the buffer as it is in-game
@@ -2277,14 +2349,14 @@ void Dwarf::commit_pending(bool single) {
     m_df->write_raw(addr, 94, buf.data());
 
     if (m_pending_nick_name != m_nick_name){
-        m_df->write_string(m_address + m_mem->dwarf_offset("nick_name"), m_pending_nick_name);
-        m_df->write_string(m_first_soul + m_mem->soul_detail("name") + m_mem->dwarf_offset("nick_name"), m_pending_nick_name);
+        m_df->write_string(m_address + m_mem->dwarf_offset(MemoryLayout::DWARF_NICK_NAME), m_pending_nick_name);
+        m_df->write_string(m_first_soul + m_mem->soul_detail(MemoryLayout::SOUL_NAME) + m_mem->dwarf_offset(MemoryLayout::DWARF_NICK_NAME), m_pending_nick_name);
         if(m_hist_figure){
             m_hist_figure->write_nick_name(m_pending_nick_name);
         }
     }
     if (m_pending_custom_profession != m_custom_prof_name)
-        m_df->write_string(m_address + m_mem->dwarf_offset("custom_profession"), m_pending_custom_profession);
+        m_df->write_string(m_address + m_mem->dwarf_offset(MemoryLayout::DWARF_CUSTOM_PROFESSION), m_pending_custom_profession);
 
     for(int i=0; i < m_unit_flags.count(); i++){
         if (m_pending_flags.at(i) != m_unit_flags.at(i)){
@@ -2340,9 +2412,9 @@ void Dwarf::commit_pending(bool single) {
 
 void Dwarf::recheck_equipment(){
     // set the "recheck_equipment" flag if there was a labor change, or squad change
-    auto recheck_equipment = m_df->read_byte(m_address + m_mem->dwarf_offset("recheck_equipment"));
+    auto recheck_equipment = m_df->read_byte(m_address + m_mem->dwarf_offset(MemoryLayout::DWARF_RECHECK_EQUIPMENT));
     recheck_equipment |= 1;
-    m_df->write_raw(m_address + m_mem->dwarf_offset("recheck_equipment"), 1, &recheck_equipment);
+    m_df->write_raw(m_address + m_mem->dwarf_offset(MemoryLayout::DWARF_RECHECK_EQUIPMENT), 1, &recheck_equipment);
 }
 
 
@@ -2740,33 +2812,41 @@ void Dwarf::calc_attribute_ratings(){
     }
 }
 
-QList<double> Dwarf::calc_role_ratings(){
-    calc_attribute_ratings();
-
-    LOGV << ":::::::::::::::::::::::::::::::::::::::::::::::::::";
-    LOGV << m_nice_name;
-
+void Dwarf::set_raw_role_ratings(const QList<Role*> &roles, const double *ratings){
     m_role_ratings.clear();
     m_raw_role_ratings.clear();
     m_sorted_role_ratings.clear();
     m_sorted_custom_role_ratings.clear();
-    double rating = 0.0;
-    foreach(Role *m_role, GameDataReader::ptr()->get_roles()){
-        if(m_role){
-            rating = calc_role_rating(m_role);
-            m_raw_role_ratings.insert(m_role->name(), rating);
-        }
+    for(int i = 0; i < roles.count(); i++){
+        m_raw_role_ratings.insert(roles.at(i)->name(), ratings[i]);
     }
-    return m_raw_role_ratings.values();
+}
+
+void Dwarf::load_role_aspect_ratings(role_aspect_ratings &ratings){
+    ratings.attributes.resize(AT_SOCIAL_AWARENESS + 1);
+    for(int id = 0; id < ratings.attributes.count(); id++){
+        ratings.attributes[id] = get_attribute(static_cast<ATTRIBUTES_TYPE>(id)).rating(true);
+    }
+    ratings.traits.resize(GameDataReader::ptr()->get_total_trait_count());
+    for(int id = 0; id < ratings.traits.count(); id++){
+        ratings.traits[id] = DwarfStats::get_trait_rating(trait(id));
+    }
+    ratings.missing_trait = DwarfStats::get_trait_rating(-1);
+    //only the skills used by a role are rated, as rating a skill adds it to the unit
+    ratings.skills.fill(-1, GameDataReader::ptr()->get_total_skill_count());
+    ratings.skill_rates.fill(0, ratings.skills.count());
 }
 
 double Dwarf::calc_role_rating(Role *m_role){
+    role_aspect_ratings ratings;
+    load_role_aspect_ratings(ratings);
+    return calc_role_rating(m_role, ratings);
+}
+
+double Dwarf::calc_role_rating(Role *m_role, role_aspect_ratings &ratings){
     //if there's a script, use this in place of any aspects
     if(!m_role->script().trimmed().isEmpty()){
-        QJSEngine m_engine;
-        QJSValue d_obj = m_engine.newQObject(this);
-        m_engine.globalObject().setProperty("d", d_obj);
-        return  m_engine.evaluate(m_role->script()).toNumber(); //just show the raw value the script generates
+        return RoleScriptEngine::rate(m_role, this);
     }
 
     LOGV << "  +" << m_role->name() << "-" << m_nice_name;
@@ -2788,28 +2868,12 @@ double Dwarf::calc_role_rating(Role *m_role){
     if((global_att_weight + global_skill_weight + global_trait_weight + global_pref_weight) == 0)
         return 50.0f;
 
-    RoleAspect *a;
     double aspect_value = 0.0;
     float total_weight = 0.0;
-    float weight = 1.0;
 
     //ATTRIBUTES
-    if(m_role->attributes.count()>0){
-
-        foreach(QString name, m_role->attributes.uniqueKeys()){
-            a = m_role->attributes.value(name);
-            weight = a->weight;
-
-            ATTRIBUTES_TYPE attrib_id = GameDataReader::ptr()->get_attribute_type(name.toUpper());
-            aspect_value = get_attribute(attrib_id).rating(true);
-
-            if(a->is_neg)
-                aspect_value = 1-aspect_value;
-            rating_att += (aspect_value*weight);
-
-            total_weight += weight;
-
-        }
+    if(!m_role->compiled_attributes().isEmpty()){
+        rating_att = Role::rate_aspects(m_role->compiled_attributes(), ratings.attributes, 0.0, total_weight);
         if(total_weight > 0){
             rating_att = (rating_att / total_weight) * 100.0f; //weighted average percentile
         }else{
@@ -2820,20 +2884,8 @@ double Dwarf::calc_role_rating(Role *m_role){
     }
 
     //TRAITS
-    if(m_role->traits.count()>0){
-        total_weight = 0;
-        foreach(QString trait_id, m_role->traits.uniqueKeys()){
-            a = m_role->traits.value(trait_id);
-            weight = a->weight;
-
-            aspect_value = DwarfStats::get_trait_rating(trait(trait_id.toInt()));
-
-            if(a->is_neg)
-                aspect_value = 1-aspect_value;
-            rating_trait += (aspect_value * weight);
-
-            total_weight += weight;
-        }
+    if(!m_role->compiled_traits().isEmpty()){
+        rating_trait = Role::rate_aspects(m_role->compiled_traits(), ratings.traits, ratings.missing_trait, total_weight);
         if(total_weight > 0){
             rating_trait = (rating_trait / total_weight) * 100.0f;//weighted average percentile
         }else{
@@ -2845,29 +2897,25 @@ double Dwarf::calc_role_rating(Role *m_role){
 
     //SKILLS
     float total_skill_rates = 0.0;
-    if(m_role->skills.count()>0){
-        total_weight = 0;
-        Skill s;
-        foreach(QString skill_id, m_role->skills.uniqueKeys()){
-            a = m_role->skills.value(skill_id);
-            weight = a->weight;
-
-            s = this->get_skill(skill_id.toInt());
-            total_skill_rates += s.skill_rate();
-            aspect_value = s.get_rating();
-
-            LOGV << "      * skill:" << s.name() << "lvl:" << s.capped_level_precise() << "sim. lvl:" << s.get_simulated_level() << "balanced lvl:" << s.get_balanced_level()
-                 << "rating:" << s.get_rating();
-
-            if(aspect_value > 1.0)
-                aspect_value = 1.0;
-
-            if(a->is_neg)
-                aspect_value = 1-aspect_value;
-            rating_skill += (aspect_value*weight);
-
-            total_weight += weight;
+    if(!m_role->compiled_skills().isEmpty()){
+        foreach(const Role::compiled_aspect &c, m_role->compiled_skills()){
+            if(c.id < 0)
+                continue;
+            while(c.id >= ratings.skills.count()){
+                ratings.skills.append(-1);
+                ratings.skill_rates.append(0);
+            }
+            if(ratings.skills.at(c.id) < 0){
+                Skill s = get_skill(c.id);
+                aspect_value = s.get_rating();
+                LOGV << "      * skill:" << s.name() << "lvl:" << s.capped_level_precise() << "sim. lvl:" << s.get_simulated_level() << "balanced lvl:" << s.get_balanced_level()
+                     << "rating:" << aspect_value;
+                ratings.skills[c.id] = qMin(aspect_value, 1.0);
+                ratings.skill_rates[c.id] = s.skill_rate();
+            }
+            total_skill_rates += ratings.skill_rates.at(c.id);
         }
+        rating_skill = Role::rate_aspects(m_role->compiled_skills(), ratings.skills, 0.0, total_weight);
         if(total_skill_rates <= 0){
             //this unit cannot improve the skills associated with this role so cancel any rating
             return 0.0001;
@@ -2919,7 +2967,7 @@ float Dwarf::get_raw_role_rating(QString role_name){
     return m_raw_role_ratings.value(role_name);
 }
 
-void Dwarf::refresh_role_display_ratings(){
+void Dwarf::refresh_role_display_ratings(bool show_custom){
     GameDataReader *gdr = GameDataReader::ptr();
     //keep a sorted list of the display ratings for tooltips, detail pane, etc.
     foreach(QString name, m_raw_role_ratings.uniqueKeys()){
@@ -2931,7 +2979,7 @@ void Dwarf::refresh_role_display_ratings(){
         sr.name = name;
         m_sorted_role_ratings.append(sr);
     }
-    if(DT->user_settings()->value("options/show_custom_roles",false).toBool()){
+    if(show_custom){
         qSort(m_sorted_role_ratings.begin(),m_sorted_role_ratings.end(),&Dwarf::sort_ratings_custom);
     }else{
         qSort(m_sorted_role_ratings.begin(),m_sorted_role_ratings.end(),&Dwarf::sort_ratings);
@@ -441,12 +441,27 @@ public:
     */
     void reset_custom_profession(bool reset_labors = false);
 
-    QList<double> calc_role_ratings();
+    //! replace the raw role ratings with ones calculated for the whole population (see RoleMatrix)
+    void set_raw_role_ratings(const QList<Role*> &roles, const double *ratings);
     double calc_role_rating(Role *);
+
+    //! ratings (0-1) of the unit's attributes, traits and skills by id, shared by all of its role ratings
+    struct role_aspect_ratings{
+        QVector<double> attributes;
+        QVector<double> traits;
+        double missing_trait;
+        QVector<double> skills; //-1 until a role rates the skill
+        QVector<int> skill_rates;
+    };
+    void load_role_aspect_ratings(role_aspect_ratings &ratings);
+    double calc_role_rating(Role *m_role, role_aspect_ratings &ratings);
     Q_INVOKABLE float get_role_rating(QString role_name);
     Q_INVOKABLE float get_raw_role_rating(QString role_name);
     QList<QPair<QString,QString> > get_role_pref_matches(QString role_name){return m_role_pref_map.value(role_name);}
-    void refresh_role_display_ratings();
+    //! units kept across refreshes are recounted, so drop the previous matches first
+    void clear_role_pref_matches(){m_role_pref_map.clear();}
+    //! doesn't touch the settings, so units can be refreshed from several threads at once
+    void refresh_role_display_ratings(bool show_custom);
 
     void calc_attribute_ratings();
 
@@ -705,10 +720,28 @@ private:
 
     QHash<int,QVariant> m_global_sort_keys;
 
+    //! copies of the unit and first soul structs; fields are decoded from these while reading
+    QByteArray m_unit_data;
+    QByteArray m_soul_data;
+
+    void read_snapshot();
+    void read_soul_snapshot();
+    void release_snapshot();
+    bool snapshot_raw(const QByteArray &data, VPTR base, VPTRDIFF offset, size_t bytes, void *buf);
+    template<typename T> T snapshot_field(const QByteArray &data, VPTR base, VPTRDIFF offset);
+    QVector<VPTR> snapshot_vector(const QByteArray &data, VPTR base, VPTRDIFF offset);
+
+    bool unit_raw(VPTRDIFF offset, size_t bytes, void *buf) {return snapshot_raw(m_unit_data, m_address, offset, bytes, buf);}
+    bool soul_raw(VPTRDIFF offset, size_t bytes, void *buf) {return snapshot_raw(m_soul_data, m_first_soul, offset, bytes, buf);}
+    template<typename T> T unit_field(VPTRDIFF offset) {return snapshot_field<T>(m_unit_data, m_address, offset);}
+    template<typename T> T soul_field(VPTRDIFF offset) {return snapshot_field<T>(m_soul_data, m_first_soul, offset);}
+    QVector<VPTR> unit_vector(VPTRDIFF offset) {return snapshot_vector(m_unit_data, m_address, offset);}
+    QVector<VPTR> soul_vector(VPTRDIFF offset) {return snapshot_vector(m_soul_data, m_first_soul, offset);}
+
     bool validate();
 
     // these methods read data from raw memory
-    void read_id();
+    int read_core_fields();
     void read_flags();
     void read_gender_orientation();
     void read_mood();
@@ -722,16 +755,14 @@ private:
     void read_states();
     void read_profession();
     void read_labors();
-    void read_happiness(VPTR personality_base);
     void read_current_job();
     bool read_soul();
     void read_soul_aspects();
     void read_skills();
     void read_attributes();
-    void load_attribute(VPTR &addr, ATTRIBUTES_TYPE id);
+    void load_attribute(int value, int limit, ATTRIBUTES_TYPE id);
     void read_personality();
-    void read_emotions(VPTR personality_base);
-    void read_turn_count();
+    void read_emotions(VPTRDIFF personality_offset);
     void read_animal_type();
     void read_noble_position();
     void read_preferences();
@@ -749,6 +780,7 @@ private:
     void process_inv_item(QString category, Item *item, bool is_contained_item=false);
 
     void set_age_and_migration(VPTR birth_year_offset, VPTR birth_time_offset);
+    void calc_age_and_migration();
 
     // assembles component names into a nicely formatted single string
     void build_names();
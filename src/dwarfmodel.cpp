@@ -71,6 +71,12 @@ void DwarfModel::clear_all(bool clr_pend) {
 
     qDeleteAll(m_dwarves);
     m_dwarves.clear();
+    clear_rows();
+
+    m_clearing_data = false;
+}
+
+void DwarfModel::clear_rows() {
     m_grouped_dwarves.clear();
 
     if(m_gridview){
@@ -83,8 +89,6 @@ void DwarfModel::clear_all(bool clr_pend) {
 
     m_total_row_count = 0;
     clear();
-
-    m_clearing_data = false;
 }
 
 void DwarfModel::section_right_clicked(int col) {
@@ -97,15 +101,24 @@ void DwarfModel::section_right_clicked(int col) {
 }
 
 void DwarfModel::load_dwarves() {
-    // clear id->dwarf map
-    clear_all(false);
+    // keep the current units around, the instance reuses the ones that haven't changed
+    QHash<int, Dwarf*> previous = m_dwarves;
+    m_clearing_data = true;
+    m_dwarves.clear();
+    clear_rows();
+    m_clearing_data = false;
 
     m_df->attach();
-    foreach(Dwarf *d, m_df->load_dwarves()) {
+    foreach(Dwarf *d, m_df->load_dwarves(previous)) {
         m_dwarves[d->id()] = d;
     }
     m_df->detach();
 
+    foreach(Dwarf *d, previous) {
+        if (m_dwarves.value(d->id()) != d)
+            delete d;
+    }
+
     emit units_refreshed();
 }
 
@@ -830,6 +843,7 @@ void DwarfModel::commit_pending() {
 
     foreach(Dwarf *d, m_dwarves) {
         if (d->pending_changes()) {
+            m_df->expire_unit(d->address());
             d->commit_pending();
         }
     }
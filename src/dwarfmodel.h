@@ -95,6 +95,7 @@ public:
     void set_grid_view(GridView *v) {m_gridview = v;}
     GridView * current_grid_view() {return m_gridview;}
     void clear_all(bool clr_pend); // reset everything to normal
+    void clear_rows(); // remove the rows and cells, but keep the units
 
     QHash<int,QPair<QString,int> > get_global_sort_info() {return m_global_sort_info;}
     QHash<int,QPair<int,Qt::SortOrder> > get_global_group_sort_info(){return m_global_group_sort_info;} //stores the last role and order for a group by key
@@ -38,6 +38,7 @@ THE SOFTWARE.
 #include "truncatingfilelogger_p.h"
 #include "viewmanager.h"
 #include "dwarfstats.h"
+#include "rolescriptengine.h"
 #include "defaultfonts.h"
 #include "dtstandarditem.h"
 #include "cellcolordef.h"
@@ -585,6 +586,7 @@ void DwarfTherapist::emit_settings_changed(){
 }
 
 void DwarfTherapist::emit_roles_changed(){
+    RoleScriptEngine::invalidate();
     emit roles_changed();
 }
 
@@ -78,9 +78,10 @@ void FortressEntity::read_entity(){
 //    m_translated_name = m_df->get_translated_word(m_address + 0x14);
 
     m_id = m_df->read_int(m_address + sizeof(VPTR ));
-    m_histfigs = m_df->enum_vec<qint32>(m_address + m_mem->hist_entity_offset("histfigs"));
+    //membership is checked for every unit, so keep the ids hashed rather than scanning them
+    m_histfigs = m_df->enum_vec<qint32>(m_address + m_mem->hist_entity_offset("histfigs")).toList().toSet();
     //load squads
-    m_squads = m_df->enum_vec<qint32>(m_address + m_mem->hist_entity_offset("squads"));
+    refresh_squads();
 
     QVector<VPTR> entities = m_df->enumerate_vector(m_mem->address("historical_entities_vector"));
     QHash<int, position> positions;
@@ -108,10 +109,15 @@ void FortressEntity::read_entity(){
             foreach(VPTR pos, addr_positions){
                 position_id = m_df->read_int(pos + m_mem->hist_entity_offset("position_id"));
                 position p;
-                p.name = m_df->read_string(pos + m_mem->hist_entity_offset("position_name"));
-                p.name_female = m_df->read_string(pos + m_mem->hist_entity_offset("position_female_name"));
-                p.name_male = m_df->read_string(pos + m_mem->hist_entity_offset("position_male_name"));
-                raw_name = m_df->read_string(pos);
+                QStringList names = m_df->read_strings(QVector<VPTR>()
+                        << pos + m_mem->hist_entity_offset("position_name")
+                        << pos + m_mem->hist_entity_offset("position_female_name")
+                        << pos + m_mem->hist_entity_offset("position_male_name")
+                        << pos);
+                p.name = names.at(0);
+                p.name_female = names.at(1);
+                p.name_male = names.at(2);
+                raw_name = names.at(3);
                 p.highlight = m_noble_colors.value(get_color_type(raw_name));
                 positions.insert(position_id,p);
             }
@@ -140,7 +146,7 @@ void FortressEntity::read_entity(){
 }
 
 void FortressEntity::refresh_squads(){
-    m_squads = m_df->enum_vec<qint32>(m_address + m_mem->hist_entity_offset("squads"));
+    m_squads = m_df->enum_vec<qint32>(m_address + m_mem->hist_entity_offset("squads")).toList().toSet();
 }
 
 void FortressEntity::load_noble_colors(){
@@ -23,6 +23,7 @@ THE SOFTWARE.
 #ifndef HIST_ENTITY_H
 #define HIST_ENTITY_H
 #include <QObject>
+#include <QSet>
 #include "utils.h"
 
 class DFInstance;
@@ -65,7 +66,7 @@ public:
     void refresh_squads();
     int get_belief_value(int id){return m_beliefs.value(id);}
     int id() {return m_id;}
-    QVector<int32_t> hist_figures() {return m_histfigs;}
+    bool has_hist_figure(int hist_id) const {return m_histfigs.contains(hist_id);}
 
     static QMap<QString,NOBLE_COLORS> m_raw_color_map;
     static QMap<QString,NOBLE_COLORS> build_color_map();
@@ -91,10 +92,10 @@ private:
     QMultiHash<int,position> m_nobles;
 
     //squads this fortress has
-    QVector<qint32> m_squads;
+    QSet<qint32> m_squads;
     //values/beliefs (id,value)
     QHash<int,int> m_beliefs;
-    QVector<int32_t> m_histfigs;
+    QSet<qint32> m_histfigs;
 
     void read_entity();
 
@@ -528,6 +528,7 @@ void GameDataReader::load_roles(){
     for (short i = 0; i < dwarf_roles; ++i) {
         u->setArrayIndex(i);
         Role *r = new Role(*u, this);
+        r->compile_aspects(this);
         r->is_custom(true);
         if(r->updated()){
             LOGI << "custom role" << r->name() << "has been updated!";
@@ -541,6 +542,7 @@ void GameDataReader::load_roles(){
     for (short i = 0; i < dwarf_roles; ++i) {
         m_data_settings->setArrayIndex(i);
         Role *r = new Role(*m_data_settings, this);
+        r->compile_aspects(this);
         if(r->updated()){
             LOGI << "default role" << r->name() << "requires updating!";
             m_def_roles_updated = true;
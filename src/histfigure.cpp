@@ -47,8 +47,8 @@ HistFigure::HistFigure(int id, DFInstance *df, QObject *parent)
     m_address = m_df->find_historical_figure(id);
     m_mem = m_df->memory_layout();
     if(m_address){
-        m_nick_addrs.append(m_address + m_mem->hist_figure_offset("hist_name") + m_mem->dwarf_offset("nick_name"));
-        m_fig_info_addr = m_df->read_addr(m_address + m_mem->hist_figure_offset("hist_fig_info"));
+        m_nick_addrs.append(m_address + m_mem->hist_figure_offset(MemoryLayout::HF_HIST_NAME) + m_mem->dwarf_offset(MemoryLayout::DWARF_NICK_NAME));
+        m_fig_info_addr = m_df->read_addr(m_address + m_mem->hist_figure_offset(MemoryLayout::HF_HIST_FIG_INFO));
         m_has_fake_identity = read_fake_identity();
         if(!DT->user_settings()->value("options/highlight_cursed", false).toBool() && m_has_fake_identity){
             return;
@@ -63,13 +63,13 @@ HistFigure::~HistFigure(){
 }
 
 void HistFigure::read_kills(){
-    VPTR kills_addr = m_df->read_addr(m_fig_info_addr + m_mem->hist_figure_offset("kills"));
+    VPTR kills_addr = m_df->read_addr(m_fig_info_addr + m_mem->hist_figure_offset(MemoryLayout::HF_KILLS));
     if(kills_addr==0)
         return;
     QVector<qint32> kill_events = m_df->enum_vec<qint32>(kills_addr);
-    QVector<qint16> race_ids = m_df->enum_vec<qint16>(kills_addr+m_mem->hist_figure_offset("killed_race_vector"));
-    QVector<qint16> undead_kills = m_df->enum_vec<qint16>(kills_addr+m_mem->hist_figure_offset("killed_undead_vector"));
-    QVector<qint16> cur_site_kills = m_df->enum_vec<qint16>(kills_addr+m_mem->hist_figure_offset("killed_counts_vector"));
+    QVector<qint16> race_ids = m_df->enum_vec<qint16>(kills_addr+m_mem->hist_figure_offset(MemoryLayout::HF_KILLED_RACE_VECTOR));
+    QVector<qint16> undead_kills = m_df->enum_vec<qint16>(kills_addr+m_mem->hist_figure_offset(MemoryLayout::HF_KILLED_UNDEAD_VECTOR));
+    QVector<qint16> cur_site_kills = m_df->enum_vec<qint16>(kills_addr+m_mem->hist_figure_offset(MemoryLayout::HF_KILLED_COUNTS_VECTOR));
     if(cur_site_kills.count() > 0){
         QHash<int,int> kills; //group by race
         for(int idx=0;idx < race_ids.size();idx++){
@@ -110,11 +110,11 @@ void HistFigure::read_kills(){
                     int hist_id = m_df->read_int(evt_addr + m_mem->hist_event_offset("killed_hist_id"));
                     VPTR h_fig_addr =  m_df->find_historical_figure(hist_id);
                     if(h_fig_addr){
-                        VPTR name_addr = h_fig_addr + m_mem->hist_figure_offset("hist_name");
+                        VPTR name_addr = h_fig_addr + m_mem->hist_figure_offset(MemoryLayout::HF_HIST_NAME);
                         kill_info ki;
                         ki.name = capitalizeEach(m_df->read_string(name_addr).append(" ").append(m_df->get_translated_word(name_addr)));
                         ki.count = 1;
-                        Race *r = m_df->get_race(m_df->read_short(h_fig_addr + m_mem->hist_figure_offset("hist_race")));
+                        Race *r = m_df->get_race(m_df->read_short(h_fig_addr + m_mem->hist_figure_offset(MemoryLayout::HF_HIST_RACE)));
                         if(r){
                             ki.creature = r->name(ki.count).toLower();
                         }
@@ -191,17 +191,17 @@ QString HistFigure::formatted_summary(bool show_no_kills, bool space_notable){
 }
 
 bool HistFigure::read_fake_identity(){
-    VPTR rep_info = m_df->read_addr(m_fig_info_addr + m_mem->hist_figure_offset("reputation"));
+    VPTR rep_info = m_df->read_addr(m_fig_info_addr + m_mem->hist_figure_offset(MemoryLayout::HF_REPUTATION));
     if(rep_info != 0){
-        int cur_ident = m_df->read_int(rep_info + m_mem->hist_figure_offset("current_ident"));
+        int cur_ident = m_df->read_int(rep_info + m_mem->hist_figure_offset(MemoryLayout::HF_CURRENT_IDENT));
         m_fake_ident_addr = m_df->find_identity(cur_ident);
-        m_fake_name_addr = m_fake_ident_addr + m_mem->hist_figure_offset("fake_name");
-        m_fake_name = capitalize(m_df->read_string(m_fake_name_addr + m_mem->dwarf_offset("first_name")));
-        m_nick_addrs.append(m_fake_ident_addr + m_mem->hist_figure_offset("fake_name") + m_mem->dwarf_offset("nick_name"));
+        m_fake_name_addr = m_fake_ident_addr + m_mem->hist_figure_offset(MemoryLayout::HF_FAKE_NAME);
+        m_fake_name = capitalize(m_df->read_string(m_fake_name_addr + m_mem->dwarf_offset(MemoryLayout::DWARF_FIRST_NAME)));
+        m_nick_addrs.append(m_fake_ident_addr + m_mem->hist_figure_offset(MemoryLayout::HF_FAKE_NAME) + m_mem->dwarf_offset(MemoryLayout::DWARF_NICK_NAME));
         m_fake_nick = m_df->read_string(m_nick_addrs.last());
         //vamps also use a fake age
-        m_fake_birth_year = m_fake_ident_addr + m_mem->hist_figure_offset("fake_birth_year");
-        m_fake_birth_time = m_fake_ident_addr + m_mem->hist_figure_offset("fake_birth_time");
+        m_fake_birth_year = m_fake_ident_addr + m_mem->hist_figure_offset(MemoryLayout::HF_FAKE_BIRTH_YEAR);
+        m_fake_birth_time = m_fake_ident_addr + m_mem->hist_figure_offset(MemoryLayout::HF_FAKE_BIRTH_TIME);
     }
     return (m_fake_ident_addr != 0);
 }
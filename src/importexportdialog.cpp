@@ -318,6 +318,7 @@ bool ImportExportDialog::setup_for_role_import() {
     for(int i = 0; i < cnt; i++) {
         s.setArrayIndex(i);
         Role *r = new Role(s, DT);
+        r->compile_aspects(GameDataReader::ptr());
         m_roles << r;
     }
     s.endArray();
@@ -26,6 +26,16 @@ THE SOFTWARE.
 #include "truncatingfilelogger.h"
 #include "word.h"
 
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+
+static const quint32 LANGUAGE_CACHE_MAGIC = 0x44544C47; //DTLG
+static const quint32 LANGUAGE_CACHE_VERSION = 1;
+
 Languages::Languages(DFInstance *df, QObject *parent)
     : QObject(parent)
     , m_address(0)
@@ -70,42 +80,133 @@ void Languages::load_data() {
 
     m_df->attach();
     LOGD << "Loading generic strings from" << hexify(generic_lang_table);
-    QVector<VPTR> generic_words = m_df->enumerate_vector(generic_lang_table);
-    LOGD << "generic words" << generic_words.size();
-    foreach(VPTR word_ptr, generic_words) {
+    QVector<VPTR> generic_words;
+    foreach(VPTR word_ptr, m_df->enumerate_vector(generic_lang_table)) {
         if (word_ptr)
-            m_language << Word::get_word(m_df, word_ptr);
+            generic_words.append(word_ptr);
     }
+    LOGD << "generic words" << generic_words.size();
+
     QVector<VPTR> languages = m_df->enumerate_vector(translation_vector);
-    int id = 0;
+    QVector<QVector<VPTR> > lang_words;
     foreach(VPTR lang, languages) {
-        QString race_name = m_df->read_string(lang);
-        TRACE << "FOUND LANG ENTRY" << hex << lang << race_name;
         VPTR lang_table = lang + word_table_offset;
-        TRACE << "Loading " << race_name << " strings from" << hex << lang_table;
-        QVector<VPTR> lang_words = m_df->enumerate_vector(lang_table);
-        TRACE << race_name << " words" << lang_words.size();
-        QStringList words_list;
-        foreach(VPTR word_ptr, lang_words) {
+        TRACE << "Loading language strings from" << hex << lang_table;
+        QVector<VPTR> word_ptrs;
+        foreach(VPTR word_ptr, m_df->enumerate_vector(lang_table)) {
             if (word_ptr)
-                words_list.append(m_df->read_string(word_ptr));
+                word_ptrs.append(word_ptr);
         }
-        m_words.insert(id, words_list);
-        id++;
+        lang_words.append(word_ptrs);
+    }
+
+    QString path = cache_path(generic_words, languages, lang_words);
+    if (!load_cache(path, generic_words, languages.count())) {
+        m_language = Word::get_words(m_df, generic_words);
+
+        // read every language's words in one batch, then split them up again
+        QVector<VPTR> all_words;
+        foreach(const QVector<VPTR> &word_ptrs, lang_words) {
+            all_words << word_ptrs;
+        }
+        QStringList strings = m_df->read_strings(all_words);
+        int start = 0;
+        for (int id = 0; id < lang_words.count(); id++) {
+            m_words.insert(id, strings.mid(start, lang_words.at(id).count()));
+            start += lang_words.at(id).count();
+        }
+        save_cache(path);
     }
     m_df->detach();
 }
 
+QString Languages::cache_path(const QVector<VPTR> &generic_words, const QVector<VPTR> &languages, const QVector<QVector<VPTR> > &lang_words) {
+    // identify the world by the table sizes and a few words from each table,
+    // which differ between worlds as every world generates its own translations
+    QVector<VPTR> samples;
+    if (!generic_words.isEmpty())
+        samples << generic_words.first() << generic_words.last();
+    for (int i = 0; i < languages.count(); i++) {
+        samples << languages.at(i);
+        if (!lang_words.at(i).isEmpty())
+            samples << lang_words.at(i).first() << lang_words.at(i).last();
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QString::number(generic_words.count()).toLatin1());
+    foreach(const QVector<VPTR> &word_ptrs, lang_words) {
+        hash.addData(QString(":%1").arg(word_ptrs.count()).toLatin1());
+    }
+    foreach(const QString &sample, m_df->read_strings(samples)) {
+        hash.addData(sample.toUtf8().append('\0'));
+    }
+
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    return QString("%1/languages-%2-%3.dat").arg(dir).arg(m_mem->checksum().toLower())
+            .arg(QString(hash.result().toHex().left(16)));
+}
+
+bool Languages::load_cache(const QString &path, const QVector<VPTR> &generic_words, int language_count) {
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly))
+        return false;
+    uchar *data = f.map(0, f.size());
+    if (!data)
+        return false;
+
+    QByteArray raw = QByteArray::fromRawData(reinterpret_cast<const char *>(data), f.size());
+    QDataStream in(raw);
+    in.setVersion(QDataStream::Qt_5_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    QList<QStringList> generic_forms;
+    QHash<int, QStringList> words;
+    in >> magic >> version;
+    if (magic == LANGUAGE_CACHE_MAGIC && version == LANGUAGE_CACHE_VERSION)
+        in >> generic_forms >> words;
+    f.unmap(data);
+
+    if (in.status() != QDataStream::Ok || magic != LANGUAGE_CACHE_MAGIC || version != LANGUAGE_CACHE_VERSION ||
+            generic_forms.count() != generic_words.count() || words.count() != language_count) {
+        LOGW << "ignoring invalid language cache" << path;
+        return false;
+    }
+
+    for (int i = 0; i < generic_forms.count(); i++) {
+        m_language << new Word(m_df, generic_words.at(i), generic_forms.at(i));
+    }
+    m_words = words;
+    LOGD << "loaded language tables from" << path;
+    return true;
+}
+
+void Languages::save_cache(const QString &path) {
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QFile f(path);
+    if (!f.open(QIODevice::WriteOnly)) {
+        LOGW << "could not write language cache" << path << f.errorString();
+        return;
+    }
+    QList<QStringList> generic_forms;
+    foreach(Word *w, m_language) {
+        generic_forms << w->forms();
+    }
+    QDataStream out(&f);
+    out.setVersion(QDataStream::Qt_5_0);
+    out << LANGUAGE_CACHE_MAGIC << LANGUAGE_CACHE_VERSION << generic_forms << m_words;
+    LOGD << "saved language tables to" << path;
+}
+
 QString Languages::language_word(VPTR addr)
 {
     QString out;
     // front_compound, rear_compound, first_adjective, second_adjective, hypen_compound
     // the_x, of_x
     QVector<QString> words;
-    int language_id = m_df->read_int(addr + m_df->memory_layout()->word_offset("language_id")); //language_name.language
+    int language_id = m_df->read_int(addr + m_df->memory_layout()->word_offset(MemoryLayout::WORD_LANGUAGE_ID)); //language_name.language
     //language_name.words
     for (int i=0; i< 7; i++){
-        QString word = word_chunk(m_df->read_int(addr + m_df->memory_layout()->word_offset("words") + i*4), language_id);
+        QString word = word_chunk(m_df->read_int(addr + m_df->memory_layout()->word_offset(MemoryLayout::WORD_WORDS) + i*4), language_id);
         words.append(word);
     }
     QString first, second, third;
@@ -130,9 +231,9 @@ QString Languages::english_word(VPTR addr)
     QVector<QString> words;
     for (int i=0; i< 7; i++){
         //enum for what word type
-        short val = m_df->read_short(addr + m_df->memory_layout()->word_offset("word_type") + 2*i);
+        short val = m_df->read_short(addr + m_df->memory_layout()->word_offset(MemoryLayout::WORD_WORD_TYPE) + 2*i);
         //words id to lookup based on the word type
-        QString word = word_chunk_declined(m_df->read_int(addr + m_df->memory_layout()->word_offset("words") + i*4), val);
+        QString word = word_chunk_declined(m_df->read_int(addr + m_df->memory_layout()->word_offset(MemoryLayout::WORD_WORDS) + i*4), val);
         words.append(word);
     }
     QString first, second, third;
@@ -54,6 +54,11 @@ private:
     QString word_chunk(uint word, int language_id);
     QString word_chunk_declined(uint word, short pos);
 
+    //the tables never change within a world, so they're cached on disk between connections
+    QString cache_path(const QVector<VPTR> &generic_words, const QVector<VPTR> &languages, const QVector<QVector<VPTR> > &lang_words);
+    bool load_cache(const QString &path, const QVector<VPTR> &generic_words, int language_count);
+    void save_cache(const QString &path);
+
 };
 
 #endif // LANGUAGES_H
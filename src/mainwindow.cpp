@@ -80,6 +80,7 @@ MainWindow::MainWindow(QWidget *parent)
     , m_df(0)
     , m_lbl_status(new QLabel(tr("Disconnected"), this))
     , m_lbl_message(new QLabel(tr("Initializing"), this))
+    , m_lbl_stale(new QLabel(this))
     , m_progress(new QProgressBar(this))
     , m_settings(0)
     , m_view_manager(0)
@@ -98,6 +99,7 @@ MainWindow::MainWindow(QWidget *parent)
     , m_act_sep_optimize(0)
     , m_btn_optimize(0)
     , m_retry_connection(0)
+    , m_benchmarked(false)
 {
     ui->setupUi(this);
 
@@ -217,6 +219,7 @@ MainWindow::MainWindow(QWidget *parent)
 
     m_progress->setVisible(false);
     statusBar()->addPermanentWidget(m_lbl_message, 0);
+    statusBar()->addPermanentWidget(m_lbl_stale, 0);
     statusBar()->addPermanentWidget(m_lbl_status, 0);
     set_interface_enabled(false);
 
@@ -307,6 +310,7 @@ void MainWindow::showEvent(QShowEvent *evt){
 MainWindow::~MainWindow() {
     delete m_lbl_status;
     delete m_lbl_message;
+    delete m_lbl_stale;
     delete m_progress;
 
     delete m_about_dialog;
@@ -434,6 +438,8 @@ void MainWindow::connect_to_df() {
             connect(m_df, SIGNAL(progress_range(int,int)), SLOT(set_progress_range(int,int)), Qt::UniqueConnection);
             connect(m_df, SIGNAL(progress_value(int)), SLOT(set_progress_value(int)), Qt::UniqueConnection);
             connect(m_df, SIGNAL(connection_interrupted()), SLOT(lost_df_connection()));
+            connect(m_df, SIGNAL(game_ticked(int)), SLOT(game_ticked(int)), Qt::UniqueConnection);
+            connect(m_df, SIGNAL(units_changed()), SLOT(units_changed()), Qt::UniqueConnection);
 
             m_df->load_game_data();
             if(m_view_manager){
@@ -447,6 +453,10 @@ void MainWindow::connect_to_df() {
             if(DT->user_settings()->value("options/read_on_startup", true).toBool()) {
                 read_dwarves();
             }
+            if(!m_benchmarked && QCoreApplication::arguments().contains("-bench")){
+                m_benchmarked = true;
+                QTimer::singleShot(0, this, SLOT(benchmark_replay()));
+            }
         }else{
             lost_df_connection(show_dc_dialog);
         }
@@ -467,6 +477,7 @@ void MainWindow::lost_df_connection(bool show_dialog) {
         m_retry_connection->stop();
     }
     emit lostConnection();
+    m_lbl_stale->clear();
     QStringList err_msg;
     if (m_df) {
         err_msg = m_df->status_err_msg();
@@ -543,11 +554,14 @@ void MainWindow::read_dwarves() {
             }
         }
     }
-    m_model->clear_all(false);
-
     m_model->set_instance(m_df);
+    bool session = m_df->reads_stop_process();
+    if(session)
+        m_df->attach();
     m_df->refresh_data();
     m_model->load_dwarves();
+    if(session)
+        m_df->detach();
 
     set_progress_message("Setting up interface...");
 
@@ -626,9 +640,72 @@ void MainWindow::read_dwarves() {
     this->setWindowTitle(QString("%1 %2").arg(tr("Dwarf Therapist - ")).arg(m_df->fortress_name()));
 
     LOGI << "completed read in" << t.elapsed() << "ms";
+    m_df->finish_recording();
+    m_lbl_stale->clear();
     set_progress_message("");
 }
 
+void MainWindow::benchmark_replay(){
+    QStringList args = QCoreApplication::arguments();
+    int idx = args.indexOf("-bench");
+    int runs = (idx + 1 < args.count() ? args.at(idx + 1).toInt() : 0);
+    if(runs <= 0 || !args.contains("-replay")){
+        LOGW << "-bench <runs> needs a snapshot to replay, see -replay <file>";
+        return;
+    }
+
+    QVector<int> game_times;
+    QVector<int> unit_times;
+    int units = 0;
+    for(int run = 0; run < runs; run++){
+        //a new instance each time, so nothing is kept from the previous run
+        delete m_df;
+        set_interface_enabled(false);
+        m_df = 0;
+        reset();
+        m_df = DFInstance::newInstance();
+        m_df->find_running_copy();
+        if(m_df->status() != DFInstance::DFS_GAME_LOADED){
+            LOGE << "the snapshot could not be loaded for run" << run + 1;
+            return;
+        }
+
+        QTime t;
+        t.start();
+        m_df->load_game_data();
+        game_times.append(t.restart());
+        read_dwarves();
+        unit_times.append(t.elapsed());
+        units = m_model->get_dwarves().count();
+        LOGI << "replay run" << run + 1 << "of" << runs << ":" << game_times.last() << "ms game data,"
+             << unit_times.last() << "ms units and rows";
+    }
+
+    qSort(game_times);
+    qSort(unit_times);
+    LOGI << "replayed" << units << "units" << runs << "times, median" << game_times.at(runs / 2)
+         << "ms game data (" << game_times.first() << "-" << game_times.last() << "ms),"
+         << unit_times.at(runs / 2) << "ms units and rows (" << unit_times.first() << "-" << unit_times.last() << "ms)";
+}
+
+void MainWindow::game_ticked(int ticks_stale){
+    if(!m_df || m_model->get_dwarves().isEmpty() || ticks_stale <= 0){
+        m_lbl_stale->clear();
+        return;
+    }
+    m_lbl_stale->setText(tr("Data is %n tick(s) old", "", ticks_stale));
+    m_lbl_stale->setToolTip(tr("Dwarf Fortress has advanced since the units were last read."));
+}
+
+void MainWindow::units_changed(){
+    //re-read when units arrive or leave, unless that would throw away pending changes
+    if(m_df && !m_model->get_dwarves().isEmpty() && !ui->btn_commit->isEnabled() &&
+            DT->user_settings()->value("options/auto_refresh_units", false).toBool()){
+        LOGI << "unit vectors changed, refreshing";
+        read_dwarves();
+    }
+}
+
 void MainWindow::save_ui_selections(){
     //clear the selected dwarf's details, save the id of the one we're showing
     DwarfDetailsDock *dock = qobject_cast<DwarfDetailsDock*>(QObject::findChild<DwarfDetailsDock*>("dock_dwarf_details"));
@@ -127,6 +127,8 @@ public slots:
     void set_progress_range(int min, int max);
     void set_progress_value(int value);
     void set_status_message(QString msg, QString tooltip_msg);
+    void game_ticked(int ticks_stale);
+    void units_changed();
 
     // misc
     void show_dwarf_details_dock(Dwarf *d = 0);
@@ -155,6 +157,7 @@ private:
     DFInstance *m_df;
     QLabel *m_lbl_status;
     QLabel *m_lbl_message;
+    QLabel *m_lbl_stale;
     QProgressBar *m_progress;
     QSettings *m_settings;
     ViewManager *m_view_manager;
@@ -179,6 +182,7 @@ private:
     QAction *m_act_btn_optimize; //this is required in addition to the button to allow easy visibility toggling
     QToolButton *m_btn_optimize;
     QTimer *m_retry_connection;
+    bool m_benchmarked;
 
     Updater *m_updater;
     NotifierWidget *m_notifier;
@@ -200,6 +204,8 @@ private:
 
 private slots:
     void set_interface_enabled(bool);
+    //! -replay <file> -bench <runs> times the whole load against the snapshot and logs the results
+    void benchmark_replay();
 
     void edit_custom_role();
     void remove_custom_role();
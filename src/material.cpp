@@ -92,14 +92,22 @@ void Material::read_material() {
         return;
 
     //read material names
-    m_state_names.insert(SOLID,m_df->read_string(m_address + m_mem->material_offset("solid_name")));
-    m_state_names.insert(LIQUID,m_df->read_string(m_address + m_mem->material_offset("liquid_name")));
-    m_state_names.insert(GAS,m_df->read_string(m_address + m_mem->material_offset("gas_name")));
-    m_state_names.insert(POWDER,m_df->read_string(m_address + m_mem->material_offset("powder_name")));
-    m_state_names.insert(PASTE,m_df->read_string(m_address + m_mem->material_offset("paste_name")));
-    m_state_names.insert(PRESSED, m_df->read_string(m_address + m_mem->material_offset("pressed_name")));
-
-    QString generic_state_name = m_df->read_string(m_address);
+    QStringList names = m_df->read_strings(QVector<VPTR>()
+            << m_address + m_mem->material_offset("solid_name")
+            << m_address + m_mem->material_offset("liquid_name")
+            << m_address + m_mem->material_offset("gas_name")
+            << m_address + m_mem->material_offset("powder_name")
+            << m_address + m_mem->material_offset("paste_name")
+            << m_address + m_mem->material_offset("pressed_name")
+            << m_address);
+    m_state_names.insert(SOLID,names.at(0));
+    m_state_names.insert(LIQUID,names.at(1));
+    m_state_names.insert(GAS,names.at(2));
+    m_state_names.insert(POWDER,names.at(3));
+    m_state_names.insert(PASTE,names.at(4));
+    m_state_names.insert(PRESSED,names.at(5));
+
+    QString generic_state_name = names.at(6);
     if(!generic_state_name.isEmpty()){
         VPTR template_addr = m_df->get_material_template(generic_state_name + "_TEMPLATE");
         if(template_addr){
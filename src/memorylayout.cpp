@@ -4,6 +4,122 @@
 #include "dfinstance.h"
 #include <QCryptographicHash>
 
+static const char *dwarf_field_names[] = {
+    "active_syndrome_vector",
+    "affection_level",
+    "animal_type",
+    "artifact_name",
+    "birth_time",
+    "birth_year",
+    "blood",
+    "body_component_info",
+    "caste",
+    "civ",
+    "counters1",
+    "counters2",
+    "counters3",
+    "current_job",
+    "curse",
+    "curse_add_flags1",
+    "custom_profession",
+    "first_name",
+    "flags1",
+    "flags2",
+    "flags3",
+    "hist_id",
+    "id",
+    "inventory",
+    "inventory_item_bodypart",
+    "inventory_item_mode",
+    "labors",
+    "layer_status_vector",
+    "limb_counters",
+    "meeting",
+    "mood",
+    "mood_skill",
+    "nick_name",
+    "pet_owner_id",
+    "physical_attrs",
+    "profession",
+    "race",
+    "recheck_equipment",
+    "sex",
+    "size_info",
+    "souls",
+    "squad_id",
+    "squad_position",
+    "states",
+    "syn_sick_flag",
+    "temp_mood",
+    "turn_count",
+    "unit_health_info",
+    "used_items_vector",
+    "wounds_vector"
+};
+static_assert(sizeof(dwarf_field_names) / sizeof(dwarf_field_names[0]) == MemoryLayout::DWARF_COUNT, "dwarf field names out of step");
+
+static const char *soul_field_names[] = {
+    "beliefs",
+    "emotions",
+    "goal_realized",
+    "goals",
+    "mental_attrs",
+    "name",
+    "orientation",
+    "personality",
+    "preferences",
+    "skills",
+    "stress_level",
+    "traits"
+};
+static_assert(sizeof(soul_field_names) / sizeof(soul_field_names[0]) == MemoryLayout::SOUL_COUNT, "soul field names out of step");
+
+static const char *word_field_names[] = {
+    "adjective",
+    "base",
+    "language_id",
+    "noun_plural",
+    "noun_singular",
+    "past_participle_verb",
+    "past_simple_verb",
+    "present_participle_verb",
+    "present_simple_verb",
+    "verb",
+    "word_type",
+    "words"
+};
+static_assert(sizeof(word_field_names) / sizeof(word_field_names[0]) == MemoryLayout::WORD_COUNT, "word field names out of step");
+
+static const char *hist_figure_field_names[] = {
+    "current_ident",
+    "fake_birth_time",
+    "fake_birth_year",
+    "fake_name",
+    "hist_fig_info",
+    "hist_name",
+    "hist_race",
+    "id",
+    "killed_counts_vector",
+    "killed_race_vector",
+    "killed_undead_vector",
+    "kills",
+    "reputation"
+};
+static_assert(sizeof(hist_figure_field_names) / sizeof(hist_figure_field_names[0]) == MemoryLayout::HF_COUNT, "hist_figure field names out of step");
+
+//! fields some shipped layouts don't have, their readers check for -1 so they aren't reported
+static const char *optional_field_names[] = {
+    "dwarf_offsets/meeting"
+};
+
+static bool is_optional_field(const QString &key){
+    for(size_t idx = 0; idx < sizeof(optional_field_names) / sizeof(optional_field_names[0]); idx++){
+        if(key == optional_field_names[idx])
+            return true;
+    }
+    return false;
+}
+
 MemoryLayout::MemoryLayout(DFInstance *df, const QFileInfo &fileinfo)
     : m_df(df)
     , m_fileinfo(fileinfo)
@@ -11,6 +127,12 @@ MemoryLayout::MemoryLayout(DFInstance *df, const QFileInfo &fileinfo)
     , m_git_sha(QString::null)
     , m_data(m_fileinfo.absoluteFilePath(), QSettings::IniFormat)
     , m_complete(true)
+    , m_unit_size(0)
+    , m_soul_size(0)
+    , m_unit_fields(DWARF_COUNT, -1)
+    , m_soul_fields(SOUL_COUNT, -1)
+    , m_word_fields(WORD_COUNT, -1)
+    , m_hist_fig_fields(HF_COUNT, -1)
 {
     TRACE << "Attempting to contruct MemoryLayout from file " << fileinfo.absoluteFilePath();
 
@@ -28,6 +150,12 @@ MemoryLayout::MemoryLayout(DFInstance *df, const QFileInfo &fileinfo, const QSet
     , m_git_sha(QString::null)
     , m_data(m_fileinfo.absoluteFilePath(), QSettings::IniFormat)
     , m_complete(true)
+    , m_unit_size(0)
+    , m_soul_size(0)
+    , m_unit_fields(DWARF_COUNT, -1)
+    , m_soul_fields(SOUL_COUNT, -1)
+    , m_word_fields(WORD_COUNT, -1)
+    , m_hist_fig_fields(HF_COUNT, -1)
 {
     foreach(QString key, data.allKeys()) {
         m_data.setValue(key, data.value(key));
@@ -77,6 +205,33 @@ void MemoryLayout::load_data() {
     for(int idx = 0; idx < FLAG_TYPE_COUNT; idx++){
         read_flags(static_cast<UNIT_FLAG_TYPE>(idx));
     }
+
+    QStringList missing;
+    resolve_fields(MEM_UNIT, dwarf_field_names, DWARF_COUNT, m_unit_fields, missing);
+    resolve_fields(MEM_SOUL, soul_field_names, SOUL_COUNT, m_soul_fields, missing);
+    resolve_fields(MEM_WORD, word_field_names, WORD_COUNT, m_word_fields, missing);
+    resolve_fields(MEM_HIST_FIG, hist_figure_field_names, HF_COUNT, m_hist_fig_fields, missing);
+    if(!missing.isEmpty())
+        LOGW << m_fileinfo.fileName() << "is missing offsets:" << missing.join(", ");
+
+    //the personality offsets are relative to the personality inside the soul
+    m_unit_size = struct_size(MEM_UNIT);
+    m_soul_size = struct_size(MEM_SOUL);
+    if(m_soul_size > 0)
+        m_soul_size += qMax<VPTRDIFF>(0, soul_detail(SOUL_PERSONALITY));
+    LOGD << "unit struct size:" << hexify(m_unit_size) << "soul struct size:" << hexify(m_soul_size);
+}
+
+uint MemoryLayout::struct_size(const MEM_SECTION &section) const {
+    VPTRDIFF max_offset = -1;
+    foreach(VPTRDIFF offset, m_offsets.value(section)){
+        if(offset > max_offset)
+            max_offset = offset;
+    }
+    if(max_offset < 0)
+        return 0;
+    //leave room for the widest field read at an offset (a vector's begin/end/capacity)
+    return max_offset + 3 * sizeof(VPTR);
 }
 
 uint MemoryLayout::read_hex(QString key) {
@@ -99,6 +254,22 @@ void MemoryLayout::read_group(const MEM_SECTION &section) {
     m_offsets.insert(section,map);
 }
 
+void MemoryLayout::resolve_fields(const MEM_SECTION &section, const char *const names[], int count,
+                                  QVector<VPTRDIFF> &fields, QStringList &missing) const {
+    const QHash<QString, VPTRDIFF> offsets = m_offsets.value(section);
+    fields.fill(-1, count);
+    for(int idx = 0; idx < count; idx++){
+        QHash<QString, VPTRDIFF>::const_iterator it = offsets.constFind(names[idx]);
+        if(it != offsets.constEnd()){
+            fields[idx] = it.value();
+        }else{
+            QString key = QString("%1/%2").arg(section_name(section)).arg(names[idx]);
+            if(!is_optional_field(key))
+                missing.append(key);
+        }
+    }
+}
+
 void MemoryLayout::read_flags(const UNIT_FLAG_TYPE &flag_type){
     QString ini_name = flag_type_name(flag_type);
     QHash<uint,QString> map = m_flags[flag_type];
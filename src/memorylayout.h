@@ -4,6 +4,8 @@
 #include "utils.h"
 #include <QSettings>
 #include <QFileInfo>
+#include <QStringList>
+#include <QVector>
 
 class DFInstance;
 
@@ -51,6 +53,110 @@ public:
         FLAG_TYPE_COUNT
     } UNIT_FLAG_TYPE;
 
+    //! offsets read for every unit or name, resolved into flat tables when the layout is loaded
+    typedef enum{
+        DWARF_ACTIVE_SYNDROME_VECTOR,
+        DWARF_AFFECTION_LEVEL,
+        DWARF_ANIMAL_TYPE,
+        DWARF_ARTIFACT_NAME,
+        DWARF_BIRTH_TIME,
+        DWARF_BIRTH_YEAR,
+        DWARF_BLOOD,
+        DWARF_BODY_COMPONENT_INFO,
+        DWARF_CASTE,
+        DWARF_CIV,
+        DWARF_COUNTERS1,
+        DWARF_COUNTERS2,
+        DWARF_COUNTERS3,
+        DWARF_CURRENT_JOB,
+        DWARF_CURSE,
+        DWARF_CURSE_ADD_FLAGS1,
+        DWARF_CUSTOM_PROFESSION,
+        DWARF_FIRST_NAME,
+        DWARF_FLAGS1,
+        DWARF_FLAGS2,
+        DWARF_FLAGS3,
+        DWARF_HIST_ID,
+        DWARF_ID,
+        DWARF_INVENTORY,
+        DWARF_INVENTORY_ITEM_BODYPART,
+        DWARF_INVENTORY_ITEM_MODE,
+        DWARF_LABORS,
+        DWARF_LAYER_STATUS_VECTOR,
+        DWARF_LIMB_COUNTERS,
+        DWARF_MEETING,
+        DWARF_MOOD,
+        DWARF_MOOD_SKILL,
+        DWARF_NICK_NAME,
+        DWARF_PET_OWNER_ID,
+        DWARF_PHYSICAL_ATTRS,
+        DWARF_PROFESSION,
+        DWARF_RACE,
+        DWARF_RECHECK_EQUIPMENT,
+        DWARF_SEX,
+        DWARF_SIZE_INFO,
+        DWARF_SOULS,
+        DWARF_SQUAD_ID,
+        DWARF_SQUAD_POSITION,
+        DWARF_STATES,
+        DWARF_SYN_SICK_FLAG,
+        DWARF_TEMP_MOOD,
+        DWARF_TURN_COUNT,
+        DWARF_UNIT_HEALTH_INFO,
+        DWARF_USED_ITEMS_VECTOR,
+        DWARF_WOUNDS_VECTOR,
+        DWARF_COUNT
+    } UNIT_FIELD;
+
+    typedef enum{
+        SOUL_BELIEFS,
+        SOUL_EMOTIONS,
+        SOUL_GOAL_REALIZED,
+        SOUL_GOALS,
+        SOUL_MENTAL_ATTRS,
+        SOUL_NAME,
+        SOUL_ORIENTATION,
+        SOUL_PERSONALITY,
+        SOUL_PREFERENCES,
+        SOUL_SKILLS,
+        SOUL_STRESS_LEVEL,
+        SOUL_TRAITS,
+        SOUL_COUNT
+    } SOUL_FIELD;
+
+    typedef enum{
+        WORD_ADJECTIVE,
+        WORD_BASE,
+        WORD_LANGUAGE_ID,
+        WORD_NOUN_PLURAL,
+        WORD_NOUN_SINGULAR,
+        WORD_PAST_PARTICIPLE_VERB,
+        WORD_PAST_SIMPLE_VERB,
+        WORD_PRESENT_PARTICIPLE_VERB,
+        WORD_PRESENT_SIMPLE_VERB,
+        WORD_VERB,
+        WORD_WORD_TYPE,
+        WORD_WORDS,
+        WORD_COUNT
+    } WORD_FIELD;
+
+    typedef enum{
+        HF_CURRENT_IDENT,
+        HF_FAKE_BIRTH_TIME,
+        HF_FAKE_BIRTH_YEAR,
+        HF_FAKE_NAME,
+        HF_HIST_FIG_INFO,
+        HF_HIST_NAME,
+        HF_HIST_RACE,
+        HF_ID,
+        HF_KILLED_COUNTS_VECTOR,
+        HF_KILLED_RACE_VECTOR,
+        HF_KILLED_UNDEAD_VECTOR,
+        HF_KILLS,
+        HF_REPUTATION,
+        HF_COUNT
+    } HIST_FIG_FIELD;
+
     static const QString section_name(const MEM_SECTION &section){
         QMap<MEM_SECTION,QString> m;
         m[MEM_UNK] = "UNK";
@@ -102,6 +208,10 @@ public:
     uint string_buffer_offset();
     uint string_length_offset();
     uint string_cap_offset();
+    //! bytes spanned by the known unit fields, used to snapshot a unit in one read
+    uint unit_size() const {return m_unit_size;}
+    //! bytes spanned by the known soul fields (including the personality), used to snapshot a soul in one read
+    uint soul_size() const {return m_soul_size;}
 
     QHash<QString, VPTRDIFF> get_section_offsets(const MEM_SECTION &section) {
         return m_offsets.value(section);
@@ -142,6 +252,11 @@ public:
     VPTRDIFF job_detail(const QString &key) const {return offset(MEM_JOB,key);}
     VPTRDIFF soul_detail(const QString &key) const {return offset(MEM_SOUL,key);}
 
+    VPTRDIFF dwarf_offset(UNIT_FIELD field) const {return m_unit_fields.at(field);}
+    VPTRDIFF soul_detail(SOUL_FIELD field) const {return m_soul_fields.at(field);}
+    VPTRDIFF word_offset(WORD_FIELD field) const {return m_word_fields.at(field);}
+    VPTRDIFF hist_figure_offset(HIST_FIG_FIELD field) const {return m_hist_fig_fields.at(field);}
+
     QHash<uint, QString> invalid_flags_1() {return get_flags(INVALID_FLAGS_1) ;}
     QHash<uint, QString> invalid_flags_2() {return get_flags(INVALID_FLAGS_2);}
     QHash<uint, QString> invalid_flags_3() {return get_flags(INVALID_FLAGS_3);}
@@ -171,10 +286,19 @@ private:
     QString m_game_version;
     QSettings m_data;
     bool m_complete;
+    uint m_unit_size;
+    uint m_soul_size;
+    QVector<VPTRDIFF> m_unit_fields;
+    QVector<VPTRDIFF> m_soul_fields;
+    QVector<VPTRDIFF> m_word_fields;
+    QVector<VPTRDIFF> m_hist_fig_fields;
 
     uint read_hex(QString key);
+    uint struct_size(const MEM_SECTION &section) const;
     void read_group(const MEM_SECTION &section);
     void read_flags(const UNIT_FLAG_TYPE &flag_type);
+    void resolve_fields(const MEM_SECTION &section, const char *const names[], int count,
+                        QVector<VPTRDIFF> &fields, QStringList &missing) const;
 };
 Q_DECLARE_METATYPE(MemoryLayout *)
 #endif
@@ -71,10 +71,15 @@ void Plant::load_data() {
 }
 
 void Plant::read_plant() {
-    m_plant_name = m_df->read_string(m_address + m_mem->plant_offset("name"));
-    m_plant_name_plural = m_df->read_string(m_address + m_mem->plant_offset("name_plural"));
-    m_leaf_name_plural = m_df->read_string(m_address + m_mem->plant_offset("name_leaf_plural"));
-    m_seed_name_plural = m_df->read_string(m_address + m_mem->plant_offset("name_seed_plural"));
+    QStringList names = m_df->read_strings(QVector<VPTR>()
+            << m_address + m_mem->plant_offset("name")
+            << m_address + m_mem->plant_offset("name_plural")
+            << m_address + m_mem->plant_offset("name_leaf_plural")
+            << m_address + m_mem->plant_offset("name_seed_plural"));
+    m_plant_name = names.at(0);
+    m_plant_name_plural = names.at(1);
+    m_leaf_name_plural = names.at(2);
+    m_seed_name_plural = names.at(3);
 
     m_flags = FlagArray(m_df,m_address+m_mem->plant_offset("flags"));
     if(m_flags.has_flag(P_SPRING) || m_flags.has_flag(P_SUMMER) || m_flags.has_flag(P_AUTUMN) || m_flags.has_flag(P_WINTER)){
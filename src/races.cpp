@@ -76,16 +76,24 @@ void Race::load_data() {
 void Race::read_race() {
     m_df->attach();
     //m_id = m_df->read_int(m_address);
-    m_name = capitalize(m_df->read_string(m_address + m_mem->race_offset("name_singular")));
+    QStringList names = m_df->read_strings(QVector<VPTR>()
+            << m_address + m_mem->race_offset("name_singular")
+            << m_address + m_mem->race_offset("name_plural")
+            << m_address + m_mem->race_offset("adjective")
+            << m_address + m_mem->race_offset("child_name_singular")
+            << m_address + m_mem->race_offset("child_name_plural")
+            << m_address + m_mem->race_offset("baby_name_singular")
+            << m_address + m_mem->race_offset("baby_name_plural"));
+    m_name = capitalize(names.at(0));
     TRACE << "RACE " << m_name << " at " << hexify(m_address);
-    m_name_plural = capitalize(m_df->read_string(m_address + m_mem->race_offset("name_plural")));
-    m_adjective = capitalize(m_df->read_string(m_address + m_mem->race_offset("adjective")));
+    m_name_plural = capitalize(names.at(1));
+    m_adjective = capitalize(names.at(2));
 
-    m_child_name = capitalize(m_df->read_string(m_address + m_mem->race_offset("child_name_singular")));
-    m_child_name_plural = capitalize(m_df->read_string(m_address + m_mem->race_offset("child_name_plural")));
+    m_child_name = capitalize(names.at(3));
+    m_child_name_plural = capitalize(names.at(4));
 
-    m_baby_name = capitalize(m_df->read_string(m_address + m_mem->race_offset("baby_name_singular")));
-    m_baby_name_plural = capitalize(m_df->read_string(m_address + m_mem->race_offset("baby_name_plural")));
+    m_baby_name = capitalize(names.at(5));
+    m_baby_name_plural = capitalize(names.at(6));
 
     if(m_baby_name == "" && m_child_name != "")
         m_baby_name = m_child_name;
@@ -92,6 +92,9 @@ Role::Role(const Role &r)
     , role_details(r.role_details)
     , m_cur_pref_len(0)
     , m_updated(false)
+    , m_compiled_attributes(r.m_compiled_attributes)
+    , m_compiled_traits(r.m_compiled_traits)
+    , m_compiled_skills(r.m_compiled_skills)
 {}
 
 Role::~Role(){
@@ -106,6 +109,42 @@ Role::~Role(){
     prefs.clear();
 }
 
+void Role::compile_aspects(GameDataReader *gdr){
+    compile_aspects(attributes, m_compiled_attributes, gdr);
+    compile_aspects(traits, m_compiled_traits, 0);
+    compile_aspects(skills, m_compiled_skills, 0);
+}
+
+void Role::compile_aspects(const QHash<QString, RoleAspect*> &list, QVector<compiled_aspect> &compiled, GameDataReader *gdr){
+    //attributes are keyed by name, traits and skills by their id
+    compiled.clear();
+    compiled.reserve(list.count());
+    foreach(QString key, list.uniqueKeys()){
+        RoleAspect *a = list.value(key);
+        compiled_aspect c;
+        c.id = gdr ? static_cast<int>(gdr->get_attribute_type(key.toUpper())) : key.toInt();
+        c.weight = a->weight;
+        c.is_neg = a->is_neg;
+        compiled.append(c);
+    }
+}
+
+double Role::rate_aspects(const QVector<compiled_aspect> &aspects, const QVector<double> &ratings,
+                          double missing, float &total_weight){
+    double rating = 0.0;
+    total_weight = 0.0;
+    const compiled_aspect *c = aspects.constData();
+    const compiled_aspect *end = c + aspects.count();
+    for(; c != end; ++c){
+        double aspect_value = (c->id >= 0 && c->id < ratings.count()) ? ratings.at(c->id) : missing;
+        if(c->is_neg)
+            aspect_value = 1-aspect_value;
+        rating += (aspect_value * c->weight);
+        total_weight += c->weight;
+    }
+    return rating;
+}
+
 void Role::parseAspect(QSettings &s, QString node, weight_info &g_weight, QHash<QString,RoleAspect*> &list, float default_weight)
 {
     qDeleteAll(list);
@@ -33,6 +33,7 @@ class Preference;
 class QSettings;
 class RoleAspect;
 class Dwarf;
+class GameDataReader;
 
 class Role : public QObject {
     Q_OBJECT
@@ -54,6 +55,13 @@ public:
         QString name;
     };
 
+    //! an aspect with its key resolved to the id of the attribute, trait or skill it rates
+    struct compiled_aspect{
+        int id;
+        float weight;
+        bool is_neg;
+    };
+
     QString name(){return m_name;}
     void name(QString name){m_name = name;}
     QString script(){return m_script;}
@@ -85,6 +93,15 @@ public:
     void write_to_ini(QSettings &s, float default_attributes_weight, float default_traits_weight, float default_skills_weight, float default_prefs_weight);
 
     Preference* has_preference(QString name);
+
+    //! resolve the attribute, trait and skill aspects to ids, must be called whenever they change
+    void compile_aspects(GameDataReader *gdr);
+    const QVector<compiled_aspect> &compiled_attributes() const {return m_compiled_attributes;}
+    const QVector<compiled_aspect> &compiled_traits() const {return m_compiled_traits;}
+    const QVector<compiled_aspect> &compiled_skills() const {return m_compiled_skills;}
+    //! weighted sum of the ratings (0-1, indexed by id) of the aspects, ids without a rating use missing
+    static double rate_aspects(const QVector<compiled_aspect> &aspects, const QVector<double> &ratings,
+                               double missing, float &total_weight);
     static const QColor color_has_prefs() {return QColor(0, 60, 128, 135);}
 
 protected:
@@ -109,5 +126,10 @@ protected:
     QString m_pref_desc;
     int m_cur_pref_len;
     bool m_updated;
+
+    QVector<compiled_aspect> m_compiled_attributes;
+    QVector<compiled_aspect> m_compiled_traits;
+    QVector<compiled_aspect> m_compiled_skills;
+    void compile_aspects(const QHash<QString, RoleAspect*> &list, QVector<compiled_aspect> &compiled, GameDataReader *gdr);
 };
 #endif // ROLE_H
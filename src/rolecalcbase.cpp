@@ -38,12 +38,30 @@ double RoleCalcBase::pos_lower(double val)const{
     return pos;
 }
 
-double RoleCalcBase::rating(double val) {
-    return base_rating(val) / 2.0f + 0.5;
+double RoleCalcBase::position_rating(const double val, unsigned lower, unsigned upper) const {
+    return base_rating(lower, upper) / 2.0f + 0.5;
 }
 
-double RoleCalcBase::base_rating(const double val){
-    return ((pos_upper(val) + pos_lower(val)) / 2.0f) / m_div;
+double RoleCalcBase::base_rating(unsigned lower, unsigned upper) const {
+    double pos_up = upper - 1; //wraps below the lowest value, the same as pos_upper
+    double pos_low = lower;
+    return ((pos_up + pos_low) / 2.0f) / m_div;
+}
+
+void RoleCalcBase::ratings(const double *vals, int count, double *out) const {
+    unsigned lower = 0;
+    unsigned upper = 0;
+    const unsigned size = m_sorted.size();
+    for(int i = 0; i < count; i++){
+        double val = vals[i];
+        while(lower < size && m_sorted.at(lower) < val)
+            lower++;
+        if(upper < lower)
+            upper = lower;
+        while(upper < size && !(val < m_sorted.at(upper)))
+            upper++;
+        out[i] = position_rating(val, lower, upper);
+    }
 }
 
 double RoleCalcBase::find_median(QVector<double> v){
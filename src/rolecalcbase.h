@@ -8,8 +8,11 @@ class RoleCalcBase{
     RoleCalcBase(const QVector<double> &sorted);
     virtual ~RoleCalcBase();
 
-    virtual double rating(const double val);
-    double base_rating(const double val);
+    //the ratings only read the sorted values, so they can be called from several threads at once
+    double rating(const double val) const {return position_rating(val, lower(val), upper(val));}
+    double base_rating(const double val) const {return base_rating(lower(val), upper(val));}
+    //rates values sorted in ascending order, walking the sorted list once instead of searching it per value
+    void ratings(const double *vals, int count, double *out) const;
 
     double operator()(double val, bool leq = true)const{
       return leq ? pos_upper(val) : pos_lower(val);}
@@ -25,5 +28,12 @@ class RoleCalcBase{
     double m_div;
     double pos_upper(double val)const;
     double pos_lower(double val)const;
+
+    //the number of sorted values below, and no greater than a value
+    unsigned lower(double val) const {return qLowerBound(m_sorted,val) - m_begin;}
+    unsigned upper(double val) const {return qUpperBound(m_sorted,val) - m_begin;}
+    //a rating given where the value falls in the sorted values
+    virtual double position_rating(const double val, unsigned lower, unsigned upper) const;
+    double base_rating(unsigned lower, unsigned upper) const;
   };
 #endif // ROLECALCBASE_H
@@ -16,15 +16,16 @@ class RoleCalcMinMax: public RoleCalcBase{
             m_diff = 1;
     }
 
-    double rating(const double val){
-        return (base_rating(val) + calc_min_max(val)) * 0.25 + 0.5f;
+  protected:
+    double position_rating(const double val, unsigned lower, unsigned upper) const {
+        return (base_rating(lower, upper) + calc_min_max(val)) * 0.25 + 0.5f;
     }
 
 private:
     double m_min;
     double m_max;
     double m_diff;
-    double calc_min_max(double val){
+    double calc_min_max(double val) const {
         return (val - m_min) / m_diff;
     }
   };
@@ -14,10 +14,11 @@ public:
         recenter_list();
     }
 
-    double rating(const double val){
+protected:
+    double position_rating(const double val, unsigned lower, unsigned upper) const {
         double adjusted_val = range_transform(val,m_sorted.first(),m_avg,m_sorted.last());
         adjusted_val = range_transform(adjusted_val,0,m_adj_median,1.0f);
-        return (base_rating(val) + adjusted_val) * 0.5f;
+        return (base_rating(lower, upper) + adjusted_val) * 0.5f;
     }
 
 private:
@@ -369,6 +369,8 @@ void roleDialog::save_role(Role *r){
     //preferences
     r->prefs_weight.weight = ui->dsb_prefs_weight->value();
     save_prefs(r);
+
+    r->compile_aspects(GameDataReader::ptr());
 }
 
 void roleDialog::save_aspects(QTableWidget &table, QHash<QString, RoleAspect*> &list){
@@ -404,8 +406,11 @@ void roleDialog::save_prefs(Role *r){
 void roleDialog::close_pressed(){
     m_dwarf = 0;
     //if we were editing and cancelled, put the role back!
-    if(m_role && !m_role->name().trimmed().isEmpty())
+    if(m_role && !m_role->name().trimmed().isEmpty()){
+        //aspects may have been removed while editing
+        m_role->compile_aspects(GameDataReader::ptr());
         GameDataReader::ptr()->get_roles().insert(m_role->name(),m_role);
+    }
     this->reject();
 }
 
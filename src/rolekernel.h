@@ -0,0 +1,79 @@
+/*
+Dwarf Therapist
+Copyright (c) 2009 Trey Stout (chmod)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#ifndef ROLEKERNEL_H
+#define ROLEKERNEL_H
+
+//the row x weights product behind RoleMatrix, kept free of Qt so tools/rolebench can build it on its own
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define ROLE_KERNEL_AVX
+#define ROLE_KERNEL_NAME "avx"
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ROLE_KERNEL_SSE2
+#define ROLE_KERNEL_NAME "sse2"
+#else
+#define ROLE_KERNEL_NAME "scalar"
+#endif
+
+//! out[r] += row[k] * weights[k * roles + r] over every column k with a non zero value
+static inline void role_multiply_scalar(const double *row, int columns, const double *weights, int roles, double *out){
+    for(int k = 0; k < columns; k++){
+        const double value = row[k];
+        if(value == 0.0)
+            continue;
+        const double *w = weights + k * roles;
+        for(int r = 0; r < roles; r++){
+            out[r] += value * w[r];
+        }
+    }
+}
+
+/*! same as role_multiply_scalar, several roles at a time. each role still adds up its columns in
+    the same order with a separate multiply and add, so the results are identical */
+static inline void role_multiply(const double *row, int columns, const double *weights, int roles, double *out){
+    for(int k = 0; k < columns; k++){
+        const double value = row[k];
+        if(value == 0.0)
+            continue;
+        const double *w = weights + k * roles;
+        int r = 0;
+#if defined(ROLE_KERNEL_AVX)
+        const __m256d v = _mm256_set1_pd(value);
+        for(; r + 4 <= roles; r += 4){
+            _mm256_storeu_pd(out + r, _mm256_add_pd(_mm256_loadu_pd(out + r), _mm256_mul_pd(v, _mm256_loadu_pd(w + r))));
+        }
+#elif defined(ROLE_KERNEL_SSE2)
+        const __m128d v = _mm_set1_pd(value);
+        for(; r + 2 <= roles; r += 2){
+            _mm_storeu_pd(out + r, _mm_add_pd(_mm_loadu_pd(out + r), _mm_mul_pd(v, _mm_loadu_pd(w + r))));
+        }
+#endif
+        for(; r < roles; r++){
+            out[r] += value * w[r];
+        }
+    }
+}
+
+#endif // ROLEKERNEL_H
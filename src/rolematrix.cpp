@@ -0,0 +1,226 @@
+/*
+Dwarf Therapist
+Copyright (c) 2009 Trey Stout (chmod)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "rolematrix.h"
+#include "dwarf.h"
+#include "dwarfstats.h"
+#include "gamedatareader.h"
+#include "role.h"
+#include "rolekernel.h"
+
+RoleMatrix::RoleMatrix(const QList<Role*> &roles)
+{
+    foreach(Role *r, roles){
+        if(r){
+            m_roles.append(r);
+            m_scripted.append(!r->script().trimmed().isEmpty());
+        }
+    }
+    const int role_count = m_roles.count();
+
+    //only the traits used by a role get a column, ids that can't have a value share the one for -1
+    int trait_count = GameDataReader::ptr()->get_total_trait_count();
+    QHash<int,int> trait_columns;
+    QHash<int,int> skill_columns;
+    foreach(Role *r, m_roles){
+        foreach(const Role::compiled_aspect &c, r->compiled_traits()){
+            int id = (c.id >= 0 && c.id < trait_count) ? c.id : -1;
+            if(!trait_columns.contains(id)){
+                trait_columns.insert(id, m_trait_ids.count());
+                m_trait_ids.append(id);
+            }
+        }
+        //only the skills used by a role are rated, as rating a skill adds it to the unit
+        foreach(const Role::compiled_aspect &c, r->compiled_skills()){
+            if(c.id >= 0 && !skill_columns.contains(c.id)){
+                skill_columns.insert(c.id, m_skill_ids.count());
+                m_skill_ids.append(c.id);
+            }
+        }
+    }
+
+    init_section(m_attributes, AT_SOCIAL_AWARENESS + 1);
+    init_section(m_traits, m_trait_ids.count());
+    init_section(m_skills, m_skill_ids.count());
+    m_skill_used.fill(0, m_skills.columns * role_count);
+
+    for(int r = 0; r < role_count; r++){
+        Role *role = m_roles.at(r);
+        foreach(const Role::compiled_aspect &c, role->compiled_attributes()){
+            add_aspect(m_attributes, c.id, r, c.weight, c.is_neg);
+        }
+        foreach(const Role::compiled_aspect &c, role->compiled_traits()){
+            add_aspect(m_traits, trait_columns.value((c.id >= 0 && c.id < trait_count) ? c.id : -1), r, c.weight, c.is_neg);
+        }
+        foreach(const Role::compiled_aspect &c, role->compiled_skills()){
+            int column = skill_columns.value(c.id, -1);
+            add_aspect(m_skills, column, r, c.weight, c.is_neg);
+            if(column >= 0)
+                m_skill_used[column * role_count + r] += 1;
+        }
+    }
+}
+
+void RoleMatrix::init_section(section &s, int columns){
+    const int role_count = m_roles.count();
+    s.columns = columns;
+    s.weights.fill(0, columns * role_count);
+    s.constants.fill(0, role_count);
+    s.total_weights.fill(0, role_count);
+    s.aspect_counts.fill(0, role_count);
+}
+
+void RoleMatrix::add_aspect(section &s, int column, int role, float weight, bool is_neg){
+    //an inverted aspect adds weight * (1 - rating), a constant less the weighted rating
+    if(column >= 0 && column < s.columns)
+        s.weights[column * m_roles.count() + role] += is_neg ? -weight : weight;
+    if(is_neg)
+        s.constants[role] += weight;
+    s.total_weights[role] += weight;
+    s.aspect_counts[role]++;
+}
+
+void RoleMatrix::resize(int units){
+    m_prefs.fill(0, units * m_roles.count());
+    m_ratings.fill(0, units * m_roles.count());
+}
+
+void RoleMatrix::load_preferences(int unit, Dwarf *d){
+    double *prefs = m_prefs.data() + unit * m_roles.count();
+    d->clear_role_pref_matches();
+    for(int r = 0; r < m_roles.count(); r++){
+        Role *role = m_roles.at(r);
+        if(role->prefs.count() > 0)
+            prefs[r] = d->get_role_pref_match_counts(role, true);
+    }
+}
+
+QVector<double> RoleMatrix::preference_values() const {
+    QVector<double> values;
+    const int role_count = m_roles.count();
+    for(int idx = 0; idx < m_prefs.count(); idx++){
+        if(m_roles.at(idx % role_count)->prefs.count() > 0)
+            values.append(m_prefs.at(idx));
+    }
+    return values;
+}
+
+void RoleMatrix::rate(int unit, Dwarf *d){
+    const int role_count = m_roles.count();
+    QVector<double> att_row(m_attributes.columns);
+    QVector<double> trait_row(m_traits.columns);
+    QVector<double> skill_row(m_skills.columns);
+    QVector<double> rate_row(m_skills.columns);
+    QVector<double> sums(4 * role_count);
+
+    d->calc_attribute_ratings();
+    for(int k = 0; k < m_attributes.columns; k++){
+        att_row[k] = d->get_attribute(static_cast<ATTRIBUTES_TYPE>(k)).rating(true);
+    }
+    for(int k = 0; k < m_traits.columns; k++){
+        int id = m_trait_ids.at(k);
+        trait_row[k] = DwarfStats::get_trait_rating(id < 0 ? -1 : d->trait(id));
+    }
+    for(int k = 0; k < m_skills.columns; k++){
+        Skill s = d->get_skill(m_skill_ids.at(k));
+        skill_row[k] = qMin(s.get_rating(), 1.0);
+        rate_row[k] = s.skill_rate();
+    }
+
+    double *att = sums.data();
+    double *trait = att + role_count;
+    double *skill = trait + role_count;
+    double *skill_rates = skill + role_count;
+    role_multiply(att_row.constData(), m_attributes.columns, m_attributes.weights.constData(), role_count, att);
+    role_multiply(trait_row.constData(), m_traits.columns, m_traits.weights.constData(), role_count, trait);
+    role_multiply(skill_row.constData(), m_skills.columns, m_skills.weights.constData(), role_count, skill);
+    role_multiply(rate_row.constData(), m_skills.columns, m_skill_used.constData(), role_count, skill_rates);
+
+    double *out = m_ratings.data() + unit * role_count;
+    for(int r = 0; r < role_count; r++){
+        if(!m_scripted.at(r))
+            out[r] = finish_rating(d, r, unit, att, trait, skill, skill_rates);
+    }
+}
+
+void RoleMatrix::rate_scripted(int unit, Dwarf *d){
+    double *out = m_ratings.data() + unit * m_roles.count();
+    Dwarf::role_aspect_ratings unused;
+    for(int r = 0; r < m_roles.count(); r++){
+        if(m_scripted.at(r))
+            out[r] = d->calc_role_rating(m_roles.at(r), unused);
+    }
+}
+
+double RoleMatrix::finish_rating(Dwarf *d, int r, int unit, const double *att, const double *trait,
+                                 const double *skill, const double *skill_rates){
+    Role *role = m_roles.at(r);
+    float global_att_weight = role->attributes_weight.weight;
+    float global_skill_weight = role->skills_weight.weight;
+    float global_trait_weight = role->traits_weight.weight;
+    float global_pref_weight = role->prefs_weight.weight;
+
+    //without weights, there's nothing to calculate
+    if((global_att_weight + global_skill_weight + global_trait_weight + global_pref_weight) == 0)
+        return 50.0f;
+
+    //weighted average percentiles of each section
+    double rating_att = 50.0f;
+    if(m_attributes.aspect_counts.at(r) > 0){
+        float total_weight = m_attributes.total_weights.at(r);
+        if(total_weight <= 0)
+            return 50.0f;
+        rating_att = ((att[r] + m_attributes.constants.at(r)) / total_weight) * 100.0f;
+    }
+
+    double rating_trait = 50.0f;
+    if(m_traits.aspect_counts.at(r) > 0){
+        float total_weight = m_traits.total_weights.at(r);
+        if(total_weight <= 0)
+            return 50.0f;
+        rating_trait = ((trait[r] + m_traits.constants.at(r)) / total_weight) * 100.0f;
+    }
+
+    double rating_skill = 50.0f;
+    if(m_skills.aspect_counts.at(r) > 0){
+        //this unit cannot improve the skills associated with this role so cancel any rating
+        if(skill_rates[r] <= 0)
+            return 0.0001;
+        float total_weight = m_skills.total_weights.at(r);
+        if(total_weight > 0)
+            rating_skill = ((skill[r] + m_skills.constants.at(r)) / total_weight) * 100.0f;
+    }
+
+    double rating_prefs = 50.0f;
+    if(role->prefs.count() > 0){
+        rating_prefs = DwarfStats::get_preference_rating(m_prefs.at(unit * m_roles.count() + r)) * 100.0f;
+    }
+
+    double rating_total = ((rating_att * global_att_weight)+(rating_skill * global_skill_weight)
+                           +(rating_trait * global_trait_weight)+(rating_prefs * global_pref_weight))
+            / (global_att_weight + global_skill_weight + global_trait_weight + global_pref_weight);
+
+    if(rating_total == 0)
+        rating_total = 0.0001;
+    return rating_total;
+}
@@ -0,0 +1,85 @@
+/*
+Dwarf Therapist
+Copyright (c) 2009 Trey Stout (chmod)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#ifndef ROLEMATRIX_H
+#define ROLEMATRIX_H
+
+#include <QHash>
+#include <QList>
+#include <QVector>
+
+class Dwarf;
+class Role;
+
+/*! rates every role for a whole population at once. each unit's attribute, trait and skill
+    ratings are a row of a units x aspects matrix and each role's aspect weights a column of an
+    aspects x roles matrix, so the weighted sums of a section are one matrix product. the result
+    matches Dwarf::calc_role_rating, including the 50 and 0.0001 edge cases */
+class RoleMatrix {
+public:
+    RoleMatrix(const QList<Role*> &roles);
+
+    //! size the results for a population, before any of the per unit calls
+    void resize(int units);
+    //! count the preference matches of every role for a unit (filling its role preference map)
+    void load_preferences(int unit, Dwarf *d);
+    //! the preference match counts of the roles with preferences, in unit order
+    QVector<double> preference_values() const;
+    /*! calculate the raw rating of every role except the scripted ones for a unit. different units
+        can be rated at once, once DwarfStats is initialised and the unit's preferences loaded */
+    void rate(int unit, Dwarf *d);
+    //! calculate the raw rating of the scripted roles for a unit, only on the GUI thread
+    void rate_scripted(int unit, Dwarf *d);
+    bool has_scripted() const {return m_scripted.contains(true);}
+
+    const QList<Role*> &roles() const {return m_roles;}
+    //! raw ratings of a unit passed to rate, in the order of roles()
+    const double *ratings(int unit) const {return m_ratings.constData() + unit * m_roles.count();}
+    const QVector<double> &all_ratings() const {return m_ratings;}
+
+private:
+    struct section{
+        int columns;
+        QVector<double> weights; //columns x roles, negated for inverted aspects
+        QVector<double> constants; //per role, the total weight of the inverted aspects
+        QVector<float> total_weights; //per role
+        QVector<int> aspect_counts; //per role
+    };
+
+    QList<Role*> m_roles;
+    QVector<bool> m_scripted; //roles rated by their script instead of their aspects
+    section m_attributes;
+    section m_traits;
+    section m_skills;
+    QVector<int> m_trait_ids; //trait id of each trait column, -1 for ids without a value
+    QVector<int> m_skill_ids; //skill id of each skill column
+    QVector<double> m_skill_used; //skills x roles, 1 if the role rates the skill
+    QVector<double> m_prefs; //units x roles, preference match counts
+    QVector<double> m_ratings; //units x roles
+
+    void init_section(section &s, int columns);
+    void add_aspect(section &s, int column, int role, float weight, bool is_neg);
+    double finish_rating(Dwarf *d, int role, int unit, const double *att, const double *trait,
+                         const double *skill, const double *skill_rates);
+};
+
+#endif // ROLEMATRIX_H
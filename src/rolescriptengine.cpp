@@ -0,0 +1,137 @@
+/*
+Dwarf Therapist
+Copyright (c) 2009 Trey Stout (chmod)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "rolescriptengine.h"
+#include "dwarf.h"
+#include "role.h"
+#include "truncatingfilelogger.h"
+
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QThreadStorage>
+#ifdef QT_QML_LIB
+# include <QJSEngine>
+#else
+# include <QScriptEngine>
+# define QJSEngine QScriptEngine
+# define QJSValue QScriptValue
+# define QJSValueList QScriptValueList
+#endif
+
+static QAtomicInt s_generation(0);
+
+//! a thread's engine with the scripts it has compiled and the units it has wrapped
+struct script_engine {
+    struct timing {
+        qint64 nsecs;
+        int calls;
+        timing() : nsecs(0), calls(0) {}
+    };
+
+    QJSEngine engine;
+    int generation;
+    QHash<QString, QJSValue> functions; // script source -> function(d), or undefined if it's not an expression
+    QHash<Dwarf*, QJSValue> units;
+    QHash<QString, timing> timings; // role name -> time spent in its script
+
+    script_engine() : generation(s_generation.load()) {}
+
+    QJSValue function(const QString &script){
+        QHash<QString, QJSValue>::const_iterator it = functions.constFind(script);
+        if(it != functions.constEnd())
+            return it.value();
+        //most scripts are a single expression, scripts with statements are evaluated as they are
+        QJSValue fn = engine.evaluate("(function(d){ return (" + script + "\n); })");
+#ifdef QT_QML_LIB
+        if(!fn.isCallable())
+#else
+        if(!fn.isFunction())
+#endif
+            fn = QJSValue();
+        functions.insert(script, fn);
+        return fn;
+    }
+
+    QJSValue unit(Dwarf *d){
+        QHash<Dwarf*, QJSValue>::iterator it = units.find(d);
+        //a unit deleted since it was wrapped leaves an empty object, possibly behind a new unit's address
+        if(it == units.end() || it.value().toQObject() != d)
+            it = units.insert(d, engine.newQObject(d));
+        return it.value();
+    }
+};
+
+static QThreadStorage<script_engine*> s_engines;
+
+static script_engine *thread_engine(){
+    if(!s_engines.hasLocalData())
+        s_engines.setLocalData(new script_engine());
+    script_engine *e = s_engines.localData();
+    int generation = s_generation.load();
+    if(e->generation != generation){
+        e->functions.clear();
+        e->units.clear();
+        e->generation = generation;
+    }
+    return e;
+}
+
+double RoleScriptEngine::rate(Role *r, Dwarf *d){
+    script_engine *e = thread_engine();
+    QElapsedTimer t;
+    t.start();
+
+    QJSValue d_obj = e->unit(d);
+    QJSValue fn = e->function(r->script());
+    QJSValue result;
+    if(!fn.isUndefined()){
+#ifdef QT_QML_LIB
+        result = fn.call(QJSValueList() << d_obj);
+#else
+        result = fn.call(QJSValue(), QJSValueList() << d_obj);
+#endif
+    }else{
+        e->engine.globalObject().setProperty("d", d_obj);
+        result = e->engine.evaluate(r->script());
+    }
+
+    script_engine::timing &tm = e->timings[r->name()];
+    tm.nsecs += t.nsecsElapsed();
+    tm.calls++;
+    return result.toNumber(); //just show the raw value the script generates
+}
+
+void RoleScriptEngine::invalidate(){
+    s_generation.fetchAndAddRelaxed(1);
+}
+
+void RoleScriptEngine::log_timings(){
+    if(!s_engines.hasLocalData())
+        return;
+    script_engine *e = s_engines.localData();
+    for(QHash<QString, script_engine::timing>::const_iterator it = e->timings.constBegin(); it != e->timings.constEnd(); ++it){
+        LOGD << "script of role" << it.key() << "ran" << it.value().calls << "times in" << it.value().nsecs / 1000000.0 << "ms";
+    }
+    e->timings.clear();
+}
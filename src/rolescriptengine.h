@@ -0,0 +1,41 @@
+/*
+Dwarf Therapist
+Copyright (c) 2009 Trey Stout (chmod)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#ifndef ROLESCRIPTENGINE_H
+#define ROLESCRIPTENGINE_H
+
+class Dwarf;
+class Role;
+
+/*! evaluates role scripts with one engine per thread. each script is compiled once into a function
+    of the unit and the units' script objects are kept, until the roles change */
+class RoleScriptEngine {
+public:
+    //! the raw value the role's script gives the unit, on the calling thread's engine
+    static double rate(Role *r, Dwarf *d);
+    //! drop the compiled scripts and unit objects of every thread's engine
+    static void invalidate();
+    //! log the time the calling thread's engine spent in each script since the last call
+    static void log_timings();
+};
+
+#endif // ROLESCRIPTENGINE_H
@@ -26,6 +26,8 @@ THE SOFTWARE.
 #include "rolecalcrecenter.h"
 #include "truncatingfilelogger.h"
 #include "dwarftherapist.h"
+#include <algorithm>
+#include <cmath>
 
 using std::unique_copy;
 using std::distance;
@@ -35,18 +37,24 @@ RoleStats::RoleStats(const QVector<double> &unsorted, const double invalid_value
     : m_null_rating(-1)
     , m_invalid(invalid_value)
     , m_override(override)
+    , m_table_min(0)
 {
     set_list(unsorted);
 }
 
 void RoleStats::set_list(const QVector<double> &unsorted){
     m_total_count = static_cast<double>(unsorted.size());
+    m_table.clear();
     set_mode(unsorted);
 }
 
 void RoleStats::set_mode(const QVector<double> &unsorted){
     m_valid = unsorted;
     qSort(m_valid);
+    m_table.clear();
+    m_memo.clear();
+    if(m_valid.isEmpty())
+        return;
     bool skewed = false;
     double valid_size = m_valid.size();
     m_median = RoleCalcBase::find_median(m_valid);
@@ -99,19 +107,20 @@ void RoleStats::set_mode(const QVector<double> &unsorted){
     LOGV << "     - base avg:" << tmp_avg;
 
     double total = 0.0;
+    QVector<double> valid_ratings(m_valid.size());
     if(skewed && !m_calc.isNull()){
-        for(QVector<double>::const_iterator it = m_valid.begin()
-            ; it != m_valid.end()
-            ; it++){
-            total += m_calc->rating(*it);
+        m_calc->ratings(m_valid.constData(), m_valid.size(), valid_ratings.data());
+        foreach(double rating, valid_ratings){
+            total += rating;
         }
         m_null_rating = ((m_total_count * 0.5f) - total) / (m_total_count - valid_size);
         LOGV << "     - null rating:" << m_null_rating;
     }
 
     if(total <= 0){
-        foreach(double val, m_valid){
-            total += get_rating(val);
+        get_ratings(m_valid.constData(), m_valid.size(), valid_ratings.data());
+        foreach(double rating, valid_ratings){
+            total += rating;
         }
     }
     if(m_null_rating != -1)
@@ -122,10 +131,83 @@ void RoleStats::set_mode(const QVector<double> &unsorted){
     LOGV << "     - min raw valid value:" << m_valid.first() << "max raw valid value:" << m_valid.last();
     LOGV << "     - min rating:" << (m_null_rating > 0 ? m_null_rating : get_rating(m_valid.first())) << "max rating:" << get_rating(m_valid.last());
     LOGV << "     - average of final ratings:" << (total / m_total_count);
+
+    //traits and raw attributes are whole numbers in a small range, they're rated from a table
+    double table_min = m_valid.first();
+    double table_max = m_valid.last();
+    if(m_invalid == std::floor(m_invalid))
+        table_min = qMin(table_min, m_invalid);
+    bool whole = (table_max - table_min < 65536);
+    for(QVector<double>::const_iterator it = m_valid.constBegin(); whole && it != m_valid.constEnd(); it++){
+        whole = (*it == std::floor(*it));
+    }
+    if(whole){
+        build_table(table_min, table_max);
+        LOGV << "     - rating table of" << m_table.count() << "values from" << m_table_min;
+    }else if(!m_calc.isNull()){
+        build_memo();
+        LOGV << "     - rating memo of" << m_memo.count() << "values";
+    }
     LOGV << "     ------------------------------";
 }
 
-double RoleStats::get_rating(double val){
+void RoleStats::build_table(double min, double max){
+    QVector<double> vals;
+    for(double val = min; val <= max; val++){
+        vals.append(val);
+    }
+    QVector<double> table(vals.count());
+    get_ratings(vals.constData(), vals.count(), table.data());
+    m_table_min = min;
+    m_table = table;
+}
+
+void RoleStats::build_memo(){
+    //skills and balanced attributes are rated for the same values the list was built from,
+    //so rate each distinct one up front in a single sorted pass
+    QVector<double> vals = m_valid;
+    vals.erase(std::unique(vals.begin(), vals.end()), vals.end());
+    QVector<double> ratings(vals.count());
+    get_ratings(vals.constData(), vals.count(), ratings.data());
+    m_memo.reserve(vals.count());
+    for(int idx = 0; idx < vals.count(); idx++){
+        m_memo.insert(vals.at(idx), ratings.at(idx));
+    }
+}
+
+double RoleStats::get_rating(double val) const {
+    double offset = val - m_table_min;
+    if(offset >= 0 && offset < m_table.count()){
+        int idx = static_cast<int>(offset);
+        if(idx == offset)
+            return m_table.at(idx);
+    }
+    if(!m_memo.isEmpty()){
+        QHash<double, double>::const_iterator it = m_memo.constFind(val);
+        if(it != m_memo.constEnd())
+            return it.value();
+    }
+    return calc_rating(val);
+}
+
+void RoleStats::get_ratings(const double *vals, int count, double *out) const {
+    int start = 0;
+    if(!m_calc.isNull()){
+        //invalid values sort first
+        if(m_null_rating != -1){
+            while(start < count && vals[start] <= m_invalid){
+                out[start++] = m_null_rating;
+            }
+        }
+        m_calc->ratings(vals + start, count - start, out + start);
+    }else{
+        for(; start < count; start++){
+            out[start] = calc_rating(vals[start]);
+        }
+    }
+}
+
+double RoleStats::calc_rating(double val) const {
     if(!m_calc.isNull()){
         if(val <= m_invalid && m_null_rating != -1){
             return m_null_rating;
@@ -133,7 +215,7 @@ double RoleStats::get_rating(double val){
             return m_calc->rating(val);
         }
     }else{
-        if(m_override){
+        if(m_override && !m_valid.isEmpty()){
             return RoleCalcBase::range_transform(val,m_valid.first(),m_median,m_valid.last());
         }else{
             return 0.0;
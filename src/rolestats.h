@@ -23,6 +23,7 @@ THE SOFTWARE.
 #ifndef ROLESTATS_H
 #define ROLESTATS_H
 
+#include <QHash>
 #include <QObject>
 #include <QSharedPointer>
 #include <QVector>
@@ -36,7 +37,10 @@ public:
     virtual ~RoleStats()
     {}
 
-    double get_rating(double val);
+    //! safe to call from several threads once the list is set
+    double get_rating(double val) const;
+    //! rates values sorted in ascending order in one pass, the same as calling get_rating for each
+    void get_ratings(const double *vals, int count, double *out) const;
     void set_list(const QVector<double> &unsorted);
 
 private:
@@ -48,7 +52,15 @@ private:
 
     QSharedPointer<RoleCalcBase> m_calc;
     QVector<double> m_valid;
+    //ratings of every whole number from m_table_min, when the list only holds whole numbers in a small range
+    QVector<double> m_table;
+    double m_table_min;
+    //ratings of the values in the list, when it gets no table
+    QHash<double, double> m_memo;
     void set_mode(const QVector<double> &unsorted);
+    void build_table(double min, double max);
+    void build_memo();
+    double calc_rating(double val) const;
 };
 
 #endif // ROLESTATS_H
@@ -247,8 +247,8 @@ void Squad::assign_to_squad(Dwarf *d, bool committing){
         }
         if(addr){
             m_df->write_int(addr,d->historical_id());
-            m_df->write_int(d->address() + m_df->memory_layout()->dwarf_offset("squad_id"), m_id);
-            m_df->write_int(d->address() + m_df->memory_layout()->dwarf_offset("squad_position"), position);
+            m_df->write_int(d->address() + m_df->memory_layout()->dwarf_offset(MemoryLayout::DWARF_SQUAD_ID), m_id);
+            m_df->write_int(d->address() + m_df->memory_layout()->dwarf_offset(MemoryLayout::DWARF_SQUAD_POSITION), position);
         }
     }else{
         position = find_position(-1); //find the first open position
@@ -275,8 +275,8 @@ bool Squad::remove_from_squad(Dwarf *d, bool committing){
                 return false;
 
             m_df->write_int(addr, -1);
-            m_df->write_int(d->address() + m_df->memory_layout()->dwarf_offset("squad_id"), -1);
-            m_df->write_int(d->address() + m_df->memory_layout()->dwarf_offset("squad_position"), -1);
+            m_df->write_int(d->address() + m_df->memory_layout()->dwarf_offset(MemoryLayout::DWARF_SQUAD_ID), -1);
+            m_df->write_int(d->address() + m_df->memory_layout()->dwarf_offset(MemoryLayout::DWARF_SQUAD_POSITION), -1);
 
         }else{
             m_uniforms.value(position)->clear();
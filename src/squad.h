@@ -49,6 +49,7 @@ public:
     void assign_to_squad(Dwarf *d, bool committing = false);
     bool remove_from_squad(Dwarf *d, bool committing = false);
     Uniform* get_uniform(int position){return m_uniforms.value(position);}
+    QList<Uniform*> get_uniforms(){return m_uniforms.values();}
     bool on_duty(int histfig_id);
 
     QTreeWidgetItem* get_pending_changes_tree();
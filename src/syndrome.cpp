@@ -47,7 +47,7 @@ Syndrome::Syndrome(DFInstance *df, VPTR addr)
     , m_has_transform(false)
 {
     m_id = m_df->read_int(addr);
-    m_is_sickness = m_df->read_byte(m_addr + m_mem->dwarf_offset("syn_sick_flag"));
+    m_is_sickness = m_df->read_byte(m_addr + m_mem->dwarf_offset(MemoryLayout::DWARF_SYN_SICK_FLAG));
 
     VPTR syn_addr = m_df->get_syndrome(m_id);
     if(syn_addr){
@@ -191,7 +191,7 @@ void UnitHealth::add_info(HealthInfo *hi, QList<HealthInfo *> &info_list){
 
 void UnitHealth::read_health_info(){
     MemoryLayout *mem = m_df->memory_layout();
-    VPTR unit_health_addr = m_df->read_addr(m_dwarf_addr + mem->dwarf_offset("unit_health_info"));
+    VPTR unit_health_addr = m_df->read_addr(m_dwarf_addr + mem->dwarf_offset(MemoryLayout::DWARF_UNIT_HEALTH_INFO));
 
     quint32 health_flags = 0;
     if(unit_health_addr){
@@ -222,11 +222,11 @@ void UnitHealth::read_health_info(){
     bool unconscious = false;
     bool sleeping = false;
 
-    VPTRDIFF base_counter_addr = mem->dwarf_offset("counters1"); //starts at winded
-    VPTRDIFF base_counter2_addr = mem->dwarf_offset("counters2"); //starts at pain
-    VPTRDIFF base_counter3_addr = mem->dwarf_offset("counters3"); //starts at paralysis
+    VPTRDIFF base_counter_addr = mem->dwarf_offset(MemoryLayout::DWARF_COUNTERS1); //starts at winded
+    VPTRDIFF base_counter2_addr = mem->dwarf_offset(MemoryLayout::DWARF_COUNTERS2); //starts at pain
+    VPTRDIFF base_counter3_addr = mem->dwarf_offset(MemoryLayout::DWARF_COUNTERS3); //starts at paralysis
 
-    VPTRDIFF base_limbs_addr = mem->dwarf_offset("limb_counters");
+    VPTRDIFF base_limbs_addr = mem->dwarf_offset(MemoryLayout::DWARF_LIMB_COUNTERS);
 
     if(m_dwarf->get_caste()){
         //the unconscious state seems to depend on whether or not the dwarf is sleeping
@@ -349,8 +349,8 @@ void UnitHealth::read_health_info(){
         }
 
         //check blood loss
-        int blood_max = m_df->read_short(m_dwarf_addr + mem->dwarf_offset("blood"));
-        int blood_curr = m_df->read_short(m_dwarf_addr + mem->dwarf_offset("blood")+0x4);
+        int blood_max = m_df->read_short(m_dwarf_addr + mem->dwarf_offset(MemoryLayout::DWARF_BLOOD));
+        int blood_curr = m_df->read_short(m_dwarf_addr + mem->dwarf_offset(MemoryLayout::DWARF_BLOOD)+0x4);
         float blood_perc = (float)blood_curr / (float)blood_max;
         if(blood_perc > 0){
             add_info(eHealth::HI_BLOOD_LOSS, (blood_perc < 0.25),(blood_perc < 0.50));
@@ -433,12 +433,12 @@ void UnitHealth::read_health_info(){
 }
 
 void UnitHealth::read_wounds(){
-    auto off = m_df->memory_layout()->dwarf_offset("body_component_info");
+    auto off = m_df->memory_layout()->dwarf_offset(MemoryLayout::DWARF_BODY_COMPONENT_INFO);
     body_part_status_flags = m_df->enum_vec<qint32>(m_dwarf_addr + off);
-    layer_status_flags = m_df->enum_vec<qint32>(m_dwarf_addr + off + m_df->memory_layout()->dwarf_offset("layer_status_vector"));
+    layer_status_flags = m_df->enum_vec<qint32>(m_dwarf_addr + off + m_df->memory_layout()->dwarf_offset(MemoryLayout::DWARF_LAYER_STATUS_VECTOR));
 
     //add the wounds based on the wounded parts
-    QVector<VPTR> wounds = m_df->enumerate_vector(m_dwarf_addr + m_df->memory_layout()->dwarf_offset("wounds_vector"));
+    QVector<VPTR> wounds = m_df->enumerate_vector(m_dwarf_addr + m_df->memory_layout()->dwarf_offset(MemoryLayout::DWARF_WOUNDS_VECTOR));
     FlagArray caste_flags;
     if(m_dwarf->get_caste()){
         caste_flags = m_dwarf->get_caste()->flags();
@@ -44,6 +44,15 @@ Word::Word(DFInstance *df, VPTR address, QObject *parent)
     refresh_data();
 }
 
+Word::Word(DFInstance *df, VPTR address, const QStringList &forms, QObject *parent)
+    : QObject(parent)
+    , m_address(address)
+    , m_df(df)
+    , m_mem(df->memory_layout())
+{
+    set_forms(forms);
+}
+
 Word::~Word() {
 }
 
@@ -51,6 +60,22 @@ Word* Word::get_word(DFInstance *df, const VPTR & address) {
     return new Word(df, address);
 }
 
+QVector<Word*> Word::get_words(DFInstance *df, const QVector<VPTR> &addresses) {
+    QVector<VPTR> ptrs;
+    ptrs.reserve(addresses.count() * form_count);
+    foreach(VPTR addr, addresses) {
+        ptrs << form_addresses(df->memory_layout(), addr);
+    }
+    QStringList forms = df->read_strings(ptrs);
+
+    QVector<Word*> words;
+    words.reserve(addresses.count());
+    for (int i = 0; i < addresses.count(); i++) {
+        words << new Word(df, addresses.at(i), forms.mid(i * form_count, form_count));
+    }
+    return words;
+}
+
 void Word::refresh_data() {
     if (!m_df || !m_df->memory_layout() || !m_df->memory_layout()->is_valid()) {
         LOGW << "refresh of Word called but we're not connected";
@@ -63,17 +88,44 @@ void Word::refresh_data() {
     read_members();
 }
 
+QVector<VPTR> Word::form_addresses(MemoryLayout *mem, VPTR address) {
+    return QVector<VPTR>()
+            << address + mem->word_offset(MemoryLayout::WORD_BASE)
+            << address + mem->word_offset(MemoryLayout::WORD_NOUN_SINGULAR)
+            << address + mem->word_offset(MemoryLayout::WORD_NOUN_PLURAL)
+            << address + mem->word_offset(MemoryLayout::WORD_ADJECTIVE)
+            << address + mem->word_offset(MemoryLayout::WORD_VERB)
+            << address + mem->word_offset(MemoryLayout::WORD_PRESENT_SIMPLE_VERB)
+            << address + mem->word_offset(MemoryLayout::WORD_PAST_SIMPLE_VERB)
+            << address + mem->word_offset(MemoryLayout::WORD_PAST_PARTICIPLE_VERB)
+            << address + mem->word_offset(MemoryLayout::WORD_PRESENT_PARTICIPLE_VERB);
+}
+
 void Word::read_members() {
-    m_base = m_df->read_string(m_address + m_mem->word_offset("base"));
+    set_forms(m_df->read_strings(form_addresses(m_mem, m_address)));
+}
+
+QStringList Word::forms() const {
+    return QStringList() << m_base << m_noun << m_plural_noun << m_adjective << m_verb
+                         << m_present_simple_verb << m_past_simple_verb
+                         << m_past_participle_verb << m_present_participle_verb;
+}
+
+void Word::set_forms(const QStringList &forms) {
+    if (forms.count() < form_count) {
+        LOGW << "incomplete word forms:" << forms.count();
+        return;
+    }
+    m_base = forms.at(0);
     TRACE << "read word " << m_base;
-    m_noun = m_df->read_string(m_address + m_mem->word_offset("noun_singular"));
-    m_plural_noun = m_df->read_string(m_address + m_mem->word_offset("noun_plural"));
-    m_adjective = m_df->read_string(m_address + m_mem->word_offset("adjective"));
+    m_noun = forms.at(1);
+    m_plural_noun = forms.at(2);
+    m_adjective = forms.at(3);
 //    m_prefix = m_df->read_string(m_address + m_mem->word_offset("prefix"));
-    m_verb = m_df->read_string(m_address + m_mem->word_offset("verb"));
-    m_present_simple_verb = m_df->read_string(m_address + m_mem->word_offset("present_simple_verb"));
-    m_past_simple_verb = m_df->read_string(m_address + m_mem->word_offset("past_simple_verb"));
-    m_past_participle_verb = m_df->read_string(m_address + m_mem->word_offset("past_participle_verb"));
-    m_present_participle_verb = m_df->read_string(m_address + m_mem->word_offset("present_participle_verb"));
+    m_verb = forms.at(4);
+    m_present_simple_verb = forms.at(5);
+    m_past_simple_verb = forms.at(6);
+    m_past_participle_verb = forms.at(7);
+    m_present_participle_verb = forms.at(8);
 }
 
@@ -27,6 +27,8 @@ THE SOFTWARE.
 
 #include <QObject>
 #include <QString>
+#include <QStringList>
+#include <QVector>
 
 class DFInstance;
 class MemoryLayout;
@@ -35,9 +37,13 @@ class Word : public QObject {
     Q_OBJECT
 public:
     Word(DFInstance *df, VPTR address, QObject *parent = 0);
+    //! builds a word from forms that were already read (or cached)
+    Word(DFInstance *df, VPTR address, const QStringList &forms, QObject *parent = 0);
     virtual ~Word();
 
     static Word* get_word(DFInstance *df, const VPTR &address);
+    //! reads many words with a single batched string read
+    static QVector<Word*> get_words(DFInstance *df, const QVector<VPTR> &addresses);
 
     //! Return the memory address (in hex) of this creature in the remote DF process
     VPTR address() {return m_address;}
@@ -55,6 +61,9 @@ public:
 
     void refresh_data();
 
+    //! every form of the word, in the order of form_addresses
+    QStringList forms() const;
+
 private:
     VPTR m_address;
     QString m_base;
@@ -72,6 +81,9 @@ private:
     MemoryLayout * m_mem;
 
     void read_members();
+    void set_forms(const QStringList &forms);
+    static QVector<VPTR> form_addresses(MemoryLayout *mem, VPTR address);
+    static const int form_count = 9;
 };
 
 #endif
@@ -0,0 +1,244 @@
+/*
+Dwarf Therapist
+Copyright (c) 2009 Trey Stout (chmod)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+/*
+rates synthetic populations both ways the role ratings have been calculated: every role walking its
+own aspects (Role::rate_aspects, as Dwarf::calc_role_rating does) and one product of each unit's
+ratings with the aspects x roles weights (RoleMatrix). checks that they agree, that the vectorised
+kernel matches the scalar one exactly, and reports how long each takes.
+
+    rolebench [units...]     (default 50 200 1000 10000)
+
+exits with 1 if any result disagrees
+*/
+
+#include "rolekernel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+//roughly the shape of the shipped roles: 97 roles, each with a few attributes, a skill or two and rarely traits
+const int role_count = 97;
+const int attribute_columns = 19;
+const int trait_columns = 50;
+const int skill_columns = 120;
+const int repeats = 5;
+const double tolerance = 1e-9;
+
+struct aspect{
+    int id;
+    float weight;
+    bool is_neg;
+};
+
+struct section{
+    std::vector<std::vector<aspect> > aspects; //per role
+    std::vector<int> used; //the columns any role rates, the only ones in the matrix
+    std::vector<double> weights; //used columns x roles, negated for inverted aspects
+    std::vector<double> constants; //per role
+    std::vector<float> total_weights; //per role
+};
+
+struct population{
+    int units;
+    std::vector<double> attributes; //units x columns
+    std::vector<double> traits;
+    std::vector<double> skills;
+};
+
+void build_section(section &s, int columns, double rated, int min_aspects, int max_aspects, std::mt19937 &rng){
+    std::bernoulli_distribution has_section(rated);
+    std::uniform_int_distribution<int> count(min_aspects, max_aspects);
+    std::uniform_int_distribution<int> column(0, columns - 1);
+    std::uniform_real_distribution<float> weight(0.25f, 2.0f);
+    std::bernoulli_distribution neg(0.2);
+
+    s.aspects.assign(role_count, std::vector<aspect>());
+    std::vector<int> column_of(columns, -1);
+    s.used.clear();
+    for(int r = 0; r < role_count; r++){
+        int n = has_section(rng) ? count(rng) : 0;
+        for(int i = 0; i < n; i++){
+            aspect a = {column(rng), weight(rng), neg(rng)};
+            s.aspects[r].push_back(a);
+            if(column_of[a.id] < 0){
+                column_of[a.id] = static_cast<int>(s.used.size());
+                s.used.push_back(a.id);
+            }
+        }
+    }
+
+    //the same transformation as RoleMatrix::add_aspect
+    s.weights.assign(s.used.size() * role_count, 0);
+    s.constants.assign(role_count, 0);
+    s.total_weights.assign(role_count, 0);
+    for(int r = 0; r < role_count; r++){
+        for(size_t i = 0; i < s.aspects[r].size(); i++){
+            const aspect &a = s.aspects[r][i];
+            s.weights[column_of[a.id] * role_count + r] += a.is_neg ? -a.weight : a.weight;
+            if(a.is_neg)
+                s.constants[r] += a.weight;
+            s.total_weights[r] += a.weight;
+        }
+    }
+}
+
+population build_population(int units, std::mt19937 &rng){
+    std::uniform_real_distribution<double> rating(0.0, 1.0);
+    std::bernoulli_distribution has_skill(0.15);
+    population p;
+    p.units = units;
+    p.attributes.resize(units * attribute_columns);
+    p.traits.resize(units * trait_columns);
+    p.skills.resize(units * skill_columns);
+    for(size_t i = 0; i < p.attributes.size(); i++)
+        p.attributes[i] = rating(rng);
+    for(size_t i = 0; i < p.traits.size(); i++)
+        p.traits[i] = rating(rng);
+    //most units only have a few skills, the rest rate 0
+    for(size_t i = 0; i < p.skills.size(); i++)
+        p.skills[i] = has_skill(rng) ? rating(rng) : 0.0;
+    return p;
+}
+
+//! the per role aspect walk of Role::rate_aspects, as a weighted average percentile
+double rate_aspects(const std::vector<aspect> &aspects, const double *ratings){
+    double rating = 0.0;
+    float total_weight = 0.0;
+    for(size_t i = 0; i < aspects.size(); i++){
+        const aspect &a = aspects[i];
+        double value = ratings[a.id];
+        if(a.is_neg)
+            value = 1 - value;
+        rating += value * a.weight;
+        total_weight += a.weight;
+    }
+    return total_weight > 0 ? (rating / total_weight) * 100.0 : 50.0;
+}
+
+void rate_per_role(const population &p, const section *sections[3], bool simd, std::vector<double> &out){
+    (void)simd;
+    out.assign(p.units * role_count * 3, 0);
+    for(int u = 0; u < p.units; u++){
+        const double *rows[3] = {&p.attributes[u * attribute_columns], &p.traits[u * trait_columns],
+                                 &p.skills[u * skill_columns]};
+        double *o = &out[u * role_count * 3];
+        for(int r = 0; r < role_count; r++){
+            for(int s = 0; s < 3; s++)
+                o[r * 3 + s] = rate_aspects(sections[s]->aspects[r], rows[s]);
+        }
+    }
+}
+
+void rate_matrix(const population &p, const section *sections[3], bool simd, std::vector<double> &out){
+    out.assign(p.units * role_count * 3, 0);
+    std::vector<double> sums(role_count);
+    std::vector<double> row;
+    for(int u = 0; u < p.units; u++){
+        const double *rows[3] = {&p.attributes[u * attribute_columns], &p.traits[u * trait_columns],
+                                 &p.skills[u * skill_columns]};
+        double *o = &out[u * role_count * 3];
+        for(int s = 0; s < 3; s++){
+            const section &sec = *sections[s];
+            const int columns = static_cast<int>(sec.used.size());
+            row.resize(columns);
+            for(int k = 0; k < columns; k++)
+                row[k] = rows[s][sec.used[k]];
+            std::fill(sums.begin(), sums.end(), 0.0);
+            if(simd)
+                role_multiply(row.data(), columns, sec.weights.data(), role_count, sums.data());
+            else
+                role_multiply_scalar(row.data(), columns, sec.weights.data(), role_count, sums.data());
+            for(int r = 0; r < role_count; r++){
+                float total_weight = sec.total_weights[r];
+                o[r * 3 + s] = total_weight > 0 ? ((sums[r] + sec.constants[r]) / total_weight) * 100.0 : 50.0;
+            }
+        }
+    }
+}
+
+typedef void (*rate_function)(const population &p, const section *sections[3], bool simd, std::vector<double> &out);
+
+double best_ms(rate_function rate, const population &p, const section *sections[3], bool simd, std::vector<double> &out){
+    double best = -1;
+    for(int i = 0; i < repeats; i++){
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        rate(p, sections, simd, out);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if(best < 0 || ms < best)
+            best = ms;
+    }
+    return best;
+}
+
+}
+
+int main(int argc, char **argv){
+    std::vector<int> sizes;
+    for(int i = 1; i < argc; i++){
+        int units = atoi(argv[i]);
+        if(units > 0)
+            sizes.push_back(units);
+    }
+    if(sizes.empty()){
+        int defaults[] = {50, 200, 1000, 10000};
+        sizes.assign(defaults, defaults + 4);
+    }
+
+    std::mt19937 rng(1234);
+    section attributes, traits, skills;
+    build_section(attributes, attribute_columns, 0.85, 3, 6, rng);
+    build_section(traits, trait_columns, 0.1, 1, 3, rng);
+    build_section(skills, skill_columns, 0.85, 1, 2, rng);
+    const section *sections[3] = {&attributes, &traits, &skills};
+
+    printf("%d roles, %s kernel, best of %d runs\n", role_count, ROLE_KERNEL_NAME, repeats);
+    printf("%8s %12s %12s %12s %10s %12s\n", "units", "per role ms", "scalar ms", "simd ms", "speedup", "max diff");
+    bool ok = true;
+    for(size_t i = 0; i < sizes.size(); i++){
+        population p = build_population(sizes[i], rng);
+        std::vector<double> per_role, scalar, simd;
+        double per_role_ms = best_ms(rate_per_role, p, sections, false, per_role);
+        double scalar_ms = best_ms(rate_matrix, p, sections, false, scalar);
+        double simd_ms = best_ms(rate_matrix, p, sections, true, simd);
+
+        double max_diff = 0;
+        for(size_t j = 0; j < per_role.size(); j++)
+            max_diff = std::max(max_diff, std::fabs(per_role[j] - simd[j]));
+        bool identical = memcmp(scalar.data(), simd.data(), scalar.size() * sizeof(double)) == 0;
+
+        printf("%8d %12.3f %12.3f %12.3f %9.2fx %12.3g%s\n", p.units, per_role_ms, scalar_ms, simd_ms,
+               simd_ms > 0 ? per_role_ms / simd_ms : 0.0, max_diff, identical ? "" : " (simd differs from scalar)");
+        if(max_diff > tolerance || !identical)
+            ok = false;
+    }
+    return ok ? 0 : 1;
+}